@@ -8,6 +8,88 @@
 #include <iterator>
 #include <memory>
 #include <algorithm>
+#include <tuple>
+#include <utility>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <array>
+#include <string>
+#include <new>
+#include <thread>
+#include <exception>
+#include <system_error>
+
+/*
+ * Vector kernels are written with the GCC/clang vector extensions instead of 
+ * ISA specific intrinsics, the compiler lowers them to whatever instruction set 
+ * it targets (SSE, AVX2, AVX-512, NEON...). Define SCA_NO_SIMD before including 
+ * this header to always use the plain loops instead.
+ */
+#if !defined(SCA_NO_SIMD) && (defined(__GNUC__) || defined(__clang__))
+#define SCA_SIMD 1
+#else 
+#define SCA_SIMD 0
+#endif
+
+// the widest vector register, in bytes, the compilation target supports
+#if defined(__AVX512F__)
+#define SCA_SIMD_BYTES 64
+#elif defined(__AVX__)
+#define SCA_SIMD_BYTES 32
+#else 
+#define SCA_SIMD_BYTES 16
+#endif
+
+/*
+ * On x86 every vector kernel is also compiled for SSE4.2, AVX2 and AVX-512, 
+ * and the widest instruction set the running CPU supports is selected the 
+ * first time a kernel is called (see `sca::simd_isa()`). A single binary can 
+ * therefore be compiled for the lowest common instruction set and still use 
+ * the best one available. Define SCA_NO_SIMD_DISPATCH before including this 
+ * header to only use the instruction set of the compilation target.
+ */
+#if SCA_SIMD && (defined(__x86_64__) || defined(__i386__)) && !defined(SCA_NO_SIMD_DISPATCH)
+#define SCA_SIMD_DISPATCH 1
+#else 
+#define SCA_SIMD_DISPATCH 0
+#endif
+
+/*
+ * Everything a kernel calls with vector arguments must be inlined into it, so 
+ * that it is compiled for the instruction set of the kernel and never called 
+ * across an ABI boundary, even in unoptimized builds.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define SCA_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else 
+#define SCA_ALWAYS_INLINE inline
+#endif
+
+// inline every call made by a function into it, regardless of its size 
+#if defined(__GNUC__) || defined(__clang__)
+#define SCA_FLATTEN __attribute__((flatten))
+#else 
+#define SCA_FLATTEN
+#endif
+
+/*
+ * GCC lowers variable vector shuffles (`__builtin_shuffle`) to a single 
+ * instruction on most targets (ie, pshufb), which vector kernels use to 
+ * compact selected lanes. On x86 the AVX-512 kernels use compress stores 
+ * instead.
+ */
+#if SCA_SIMD && defined(__GNUC__) && !defined(__clang__)
+#define SCA_SIMD_SHUFFLE 1
+#else 
+#define SCA_SIMD_SHUFFLE 0
+#endif
+
+#if SCA_SIMD_SHUFFLE && (defined(__x86_64__) || defined(__i386__))
+#define SCA_SIMD_COMPRESS 1
+#else 
+#define SCA_SIMD_COMPRESS 0
+#endif
 
 /**
  * A NOTE ON API DESIGN
@@ -41,15 +123,58 @@
  * - const_slice_of - const object capable of iterating a subset of a container
  * - slice() - return a slice_of<T> (potentially const_slice_of<T>) capable of iterating a subset of a container
  * - mslice() - return an mutable slice_of<T> capable of iterating a mutable subset of a container
+ * - range_of - object capable of iterating any pair of iterators, including single pass input iterators 
+ * - range() - return a range_of<IT> so an iterator pair (ie, `std::istream_iterator`s) can be passed to algorithms
+ * - where() - return the indices of elements which return true when applied to a Callable
+ * - gather() - return a container of the elements at the given indices of another container
+ * - soa_vector - container storing each member of a row in its own contiguous column
+ * - to_columns() - return a soa_vector of selected members of each element of a container of structs
+ * - to_rows() - return a container of structs assembled from the columns of a soa_vector
  * - group() - return a container composed of all elements of all argument containers
+ * - merge() - return a sorted container composed of all elements of all argument sorted containers
+ * - flat_map - open addressing hash map whose slots are probed 16 at a time through a control byte array
+ * - flat_set - open addressing hash set whose slots are probed 16 at a time through a control byte array
+ * - groups - object storing the elements of a container contiguously by key 
+ * - group_by() - return a `groups` object storing the elements of a container contiguously by key
+ * - hash_join() - return the results of applying every pair of elements of two containers with equal keys to a Callable
+ * - partitioned_hash_join() - hash_join() which partitions large inputs so each partition's hash table fits in cache
+ * - parallel - tag requesting an algorithm split its work between several threads
+ * - distinct() - return a container of the first occurrence of every distinct element of a container
+ * - unique() - return a container of the elements of a sorted container without consecutive duplicates
+ * - count_by() - return a `flat_map` of the count of elements of a container with each key
  * - reverse() - return a container whose elements are in reverse order of input container 
  * - sort() = return a container whose elements are sorted based on a comparison Callable
+ * - sort_by() - return a container whose elements are sorted by a key computed once per element
+ * - network_sort() - return a std::array whose elements are sorted with a sorting network
+ * - stable_sort() - return a container whose elements are stably sorted, exploiting already sorted runs
+ * - top_k() - return a sorted container of the first k elements a comparison Callable would sort to
+ * - partial_sort() - return a container whose first k elements are sorted based on a comparison Callable
+ * - nth() - return a container partitioned around the element a comparison Callable would sort to index n
+ * - string_sort() - return a container whose strings are sorted in ascending order, comparing 8 cached bytes at a time
+ * - radix_sort() - return a container whose arithmetic elements (or keys) are sorted in ascending order with a radix sort
+ * - gt(), ge(), lt(), le(), eq(), ne() - return a predicate comparing elements to a value
  * - filter() - return a container filled with only elements which return true when applied to a Callable
  * - map() - return the results of applying all elements of argument containers to a Callable
  * - fold() - calculate a result after iterating through all elements of argument containers
+ * - fold_into() - update a state in place with every element of argument containers, returning the state
+ * - fold_while() - update a state in place with elements of argument containers while a Callable returns true
+ * - fold_until() - update a state in place with elements of argument containers until a Callable returns true
  * - each() - apply a Callable to every element of a container
  * - all() - return true if all elements return true when applied to a Callable
  * - some() - return true if at least one element returns true when applied to a Callable
+ * - isa - enumeration of the instruction sets vector kernels can be compiled for
+ * - simd_isa() - return the instruction set vector kernels use on the running CPU
+ * - isa_name() - return the name of an instruction set
+ * - reassociate - tag permitting floating point reductions to reorder their arithmetic
+ * - sum() - return the sum of all elements in a container
+ * - min() - return the smallest element in a container
+ * - max() - return the largest element in a container
+ * - minmax() - return the smallest and largest elements in a container
+ * - dot() - return the sum of the products of the elements of two containers grouped by index
+ * - map_fold() - reduce the results of applying all elements of argument containers to a Callable, without storing them
+ * - histogram() - return the count of elements of a container falling into each of a number of equal width bins
+ * - agg - namespace of accumulators (sum, min, max, count, mean) passed to aggregate()
+ * - aggregate() - return the results of several accumulators computed in a single pass over a container
  */
 
 namespace sca { // simple cpp algorithm
@@ -68,12 +193,27 @@ using is_lvalue_ref_t = typename std::is_lvalue_reference<C>::type;
 template <typename C>
 using to_vector_t = std::vector<typename std::decay_t<C>::value_type>;
 
+// ----------------------------------------------------------------------------- 
+// is_single_pass_t
+
+// `std::true_type` if a container's iterators can only traverse it once, as is 
+// the case for `std::istream_iterator`s. The size of such a container cannot 
+// be known without consuming it.
+template <typename C>
+using is_single_pass_t = typename std::is_same<
+    typename std::iterator_traits<
+        decltype(std::declval<std::decay_t<C>&>().begin())
+    >::iterator_category,
+    std::input_iterator_tag
+>::type;
+
 // ----------------------------------------------------------------------------- 
 // container_reference_value_t  
 
-// acquire the ::value_type of a container<T> (normally T) as a reference (T&)
+// acquire the type a container's iterator dereferences to, normally a 
+// reference to its ::value_type (T&), or a proxy object (ie, `soa_vector` rows)
 template <typename C>
-using container_reference_value_t = typename std::decay_t<C>::value_type&;
+using container_reference_value_t = decltype(*std::declval<std::remove_reference_t<C>&>().begin());
 
 // ----------------------------------------------------------------------------- 
 // callable_return_t 
@@ -114,6 +254,479 @@ size_t size(C& c, std::false_type) {
     return std::distance(c.begin(), c.end());
 }
 
+// -----------------------------------------------------------------------------
+// data  
+
+template <typename C>
+struct has_data_struct {
+    typedef typename std::remove_reference_t<C> BT; // remove any references from C, but keep const
+    template <typename U, typename P = decltype(std::declval<U&>().data())>
+    static typename std::is_same<P, decltype(&*std::declval<U&>().begin())>::type test(int);
+    template <typename U> static std::false_type test(...);
+    static const bool has = decltype(test<BT>(0))::value;
+};
+
+// `std::true_type` if a container stores its elements contiguously behind a `data()` pointer
+template <typename C>
+using has_data = std::integral_constant<bool, detail::has_data_struct<C>::has>;
+
+// Prefer raw pointers to contiguous storage, they are the easiest iterators 
+// for a compiler to reason about (and vectorize)
+template <typename C>
+auto begin(C& c, std::true_type) {
+    return c.data();
+}
+
+template <typename C>
+auto begin(C& c, std::false_type) {
+    return c.begin();
+}
+
+template <typename C>
+auto begin(C& c) {
+    return detail::begin(c, detail::has_data<C>());
+}
+
+template <typename C>
+auto end(C& c, std::true_type) {
+    return c.data() + c.size();
+}
+
+template <typename C>
+auto end(C& c, std::false_type) {
+    return c.end();
+}
+
+template <typename C>
+auto end(C& c) {
+    return detail::end(c, detail::has_data<C>());
+}
+
+// -----------------------------------------------------------------------------
+// is_random_access_t
+
+template <typename... ITs>
+struct is_random_access_struct;
+
+template <>
+struct is_random_access_struct<> {
+    static const bool is = true;
+};
+
+template <typename IT, typename... ITs>
+struct is_random_access_struct<IT, ITs...> {
+    static const bool is = std::is_base_of<
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<std::decay_t<IT>>::iterator_category
+        >::value && is_random_access_struct<ITs...>::is;
+};
+
+// `std::true_type` if every iterator can be offset by an index in constant time
+template <typename... ITs>
+using is_random_access_t = std::integral_constant<bool, detail::is_random_access_struct<ITs...>::is>;
+
+// -----------------------------------------------------------------------------
+// simd  
+
+#if SCA_SIMD
+// a vector register holding `BYTES / sizeof(T)` lanes of arithmetic type `T`
+template <typename T, size_t BYTES>
+struct vector_of {
+    typedef T type __attribute__((vector_size(BYTES)));
+    typedef decltype(std::declval<type>() < std::declval<type>()) mask;
+    static const size_t lanes = BYTES / sizeof(T);
+};
+
+/*
+ * Vectors are passed to and from the helpers below by reference, never by 
+ * value. Passing a vector wider than the compilation target's registers by 
+ * value has no stable ABI, which GCC reports with a -Wpsabi note in user code.
+ */
+
+// unaligned vector load, compiles to a single instruction
+template <typename V, typename T>
+SCA_ALWAYS_INLINE void load(V& v, const T* p) {
+    std::memcpy(&v, p, sizeof(V));
+}
+
+// unaligned vector store, compiles to a single instruction
+template <typename V, typename T>
+SCA_ALWAYS_INLINE void store(T* p, const V& v) {
+    std::memcpy(p, &v, sizeof(V));
+}
+
+// a vector with every lane set to `t`
+template <typename V, typename T>
+SCA_ALWAYS_INLINE void broadcast(V& v, const T& t) {
+    for(size_t i = 0; i < sizeof(V) / sizeof(T); ++i) {
+        v[i] = t;
+    }
+}
+
+// `true` if any lane of a comparison mask is set
+template <typename M>
+SCA_ALWAYS_INLINE bool any_lane(const M& m) {
+    uint64_t words[sizeof(M) / sizeof(uint64_t)];
+    std::memcpy(words, &m, sizeof(M));
+    uint64_t acc = 0;
+
+    for(size_t i = 0; i < sizeof(M) / sizeof(uint64_t); ++i) {
+        acc |= words[i];
+    }
+
+    return acc != 0;
+}
+
+// `true` if every lane of a comparison mask is set
+template <typename M>
+SCA_ALWAYS_INLINE bool all_lanes(const M& m) {
+    uint64_t words[sizeof(M) / sizeof(uint64_t)];
+    std::memcpy(words, &m, sizeof(M));
+    uint64_t acc = ~uint64_t(0);
+
+    for(size_t i = 0; i < sizeof(M) / sizeof(uint64_t); ++i) {
+        acc &= words[i];
+    }
+
+    return acc == ~uint64_t(0);
+}
+
+// a bitmask with bit `i` set if lane `i` of a 16 byte comparison mask is set
+SCA_ALWAYS_INLINE uint32_t byte_lane_bits(const vector_of<char, 16>::type& m) {
+#if defined(__SSE2__)
+    return uint32_t(__builtin_ia32_pmovmskb128(m));
+#else 
+    uint32_t bits = 0;
+
+    for(size_t i = 0; i < 16; ++i) {
+        bits |= uint32_t(m[i] & 1) << i;
+    }
+
+    return bits;
+#endif
+}
+#endif
+
+// element-wise operations which apply equally to scalars and vectors, vector 
+// results are written to their first argument
+struct add_op { 
+    template <typename V> 
+    SCA_ALWAYS_INLINE V operator()(const V& a, const V& b) const { return a + b; } 
+    template <typename V> 
+    SCA_ALWAYS_INLINE void operator()(V& r, const V& a, const V& b) const { r = a + b; } 
+};
+
+struct sub_op { 
+    template <typename V> 
+    SCA_ALWAYS_INLINE V operator()(const V& a, const V& b) const { return a - b; } 
+    template <typename V> 
+    SCA_ALWAYS_INLINE void operator()(V& r, const V& a, const V& b) const { r = a - b; } 
+};
+
+struct mul_op { 
+    template <typename V> 
+    SCA_ALWAYS_INLINE V operator()(const V& a, const V& b) const { return a * b; } 
+    template <typename V> 
+    SCA_ALWAYS_INLINE void operator()(V& r, const V& a, const V& b) const { r = a * b; } 
+};
+
+struct div_op { 
+    template <typename V> 
+    SCA_ALWAYS_INLINE V operator()(const V& a, const V& b) const { return a / b; } 
+    template <typename V> 
+    SCA_ALWAYS_INLINE void operator()(V& r, const V& a, const V& b) const { r = a / b; } 
+};
+
+struct and_op { 
+    template <typename V> 
+    SCA_ALWAYS_INLINE V operator()(const V& a, const V& b) const { return a & b; } 
+    template <typename V> 
+    SCA_ALWAYS_INLINE void operator()(V& r, const V& a, const V& b) const { r = a & b; } 
+};
+
+struct or_op { 
+    template <typename V> 
+    SCA_ALWAYS_INLINE V operator()(const V& a, const V& b) const { return a | b; } 
+    template <typename V> 
+    SCA_ALWAYS_INLINE void operator()(V& r, const V& a, const V& b) const { r = a | b; } 
+};
+
+struct xor_op { 
+    template <typename V> 
+    SCA_ALWAYS_INLINE V operator()(const V& a, const V& b) const { return a ^ b; } 
+    template <typename V> 
+    SCA_ALWAYS_INLINE void operator()(V& r, const V& a, const V& b) const { r = a ^ b; } 
+};
+
+struct min_op { 
+    template <typename V> 
+    SCA_ALWAYS_INLINE V operator()(const V& a, const V& b) const { return b < a ? b : a; } 
+    template <typename V> 
+    SCA_ALWAYS_INLINE void operator()(V& r, const V& a, const V& b) const { r = b < a ? b : a; } 
+};
+
+struct max_op { 
+    template <typename V> 
+    SCA_ALWAYS_INLINE V operator()(const V& a, const V& b) const { return a < b ? b : a; } 
+    template <typename V> 
+    SCA_ALWAYS_INLINE void operator()(V& r, const V& a, const V& b) const { r = a < b ? b : a; } 
+};
+
+// comparisons return a `bool` for scalars and write a lane mask for vectors
+struct gt_op { 
+    template <typename A, typename B> 
+    SCA_ALWAYS_INLINE auto operator()(const A& a, const B& b) const { return a > b; } 
+    template <typename M, typename A, typename B> 
+    SCA_ALWAYS_INLINE void operator()(M& m, const A& a, const B& b) const { m = a > b; } 
+};
+
+struct ge_op { 
+    template <typename A, typename B> 
+    SCA_ALWAYS_INLINE auto operator()(const A& a, const B& b) const { return a >= b; } 
+    template <typename M, typename A, typename B> 
+    SCA_ALWAYS_INLINE void operator()(M& m, const A& a, const B& b) const { m = a >= b; } 
+};
+
+struct lt_op { 
+    template <typename A, typename B> 
+    SCA_ALWAYS_INLINE auto operator()(const A& a, const B& b) const { return a < b; } 
+    template <typename M, typename A, typename B> 
+    SCA_ALWAYS_INLINE void operator()(M& m, const A& a, const B& b) const { m = a < b; } 
+};
+
+struct le_op { 
+    template <typename A, typename B> 
+    SCA_ALWAYS_INLINE auto operator()(const A& a, const B& b) const { return a <= b; } 
+    template <typename M, typename A, typename B> 
+    SCA_ALWAYS_INLINE void operator()(M& m, const A& a, const B& b) const { m = a <= b; } 
+};
+
+struct eq_op { 
+    template <typename A, typename B> 
+    SCA_ALWAYS_INLINE auto operator()(const A& a, const B& b) const { return a == b; } 
+    template <typename M, typename A, typename B> 
+    SCA_ALWAYS_INLINE void operator()(M& m, const A& a, const B& b) const { m = a == b; } 
+};
+
+struct ne_op { 
+    template <typename A, typename B> 
+    SCA_ALWAYS_INLINE auto operator()(const A& a, const B& b) const { return a != b; } 
+    template <typename M, typename A, typename B> 
+    SCA_ALWAYS_INLINE void operator()(M& m, const A& a, const B& b) const { m = a != b; } 
+};
+
+// the instruction sets vector kernels can be compiled for
+enum class isa {
+    none, // vector kernels are disabled, see SCA_NO_SIMD
+    native, // vector kernels use the instruction set of the compilation target
+    sse4_2,
+    avx2,
+    avx512
+};
+
+// `true` if the running CPU can execute kernels compiled for instruction set `i`
+inline bool cpu_supports(isa i) {
+#if SCA_SIMD_DISPATCH
+    __builtin_cpu_init();
+
+    switch(i) {
+        case isa::avx512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+        case isa::avx2:
+            return __builtin_cpu_supports("avx2");
+        case isa::sse4_2:
+            return __builtin_cpu_supports("sse4.2");
+        default:
+            return i == isa::native ? SCA_SIMD : true;
+    }
+#else 
+    return i == isa::none || (SCA_SIMD && i == isa::native);
+#endif
+}
+
+// select the widest instruction set the running CPU supports
+inline isa detect_isa() {
+    if(!SCA_SIMD) {
+        return isa::none;
+    } else if(detail::cpu_supports(isa::avx512)) {
+        return isa::avx512;
+    } else if(detail::cpu_supports(isa::avx2)) {
+        return isa::avx2;
+    } else if(detail::cpu_supports(isa::sse4_2)) {
+        return isa::sse4_2;
+    } else {
+        return isa::native;
+    }
+}
+
+// the instruction set is detected once, the first time it is needed
+inline isa simd_isa() {
+    static const isa chosen = detail::detect_isa();
+    return chosen;
+}
+
+#if SCA_SIMD
+#if SCA_SIMD_DISPATCH
+/*
+ * Instantiate kernel `K` for each instruction set. Kernels and everything 
+ * they call are always inlined, so they are compiled with the target of these 
+ * functions.
+ */
+template <typename K, typename... As>
+__attribute__((target("avx512f,avx512bw"))) 
+auto run_avx512(As... as) {
+    return K::template run<64>(as...);
+}
+
+template <typename K, typename... As>
+__attribute__((target("avx2"))) 
+auto run_avx2(As... as) {
+    return K::template run<32>(as...);
+}
+
+template <typename K, typename... As>
+__attribute__((target("sse4.2"))) 
+auto run_sse4_2(As... as) {
+    return K::template run<16>(as...);
+}
+#endif
+
+// run kernel `K` compiled for instruction set `i`, which the CPU must support
+template <typename K, typename... As>
+auto simd_run(isa i, As... as) {
+    switch(i) {
+#if SCA_SIMD_DISPATCH
+        case isa::avx512:
+            return detail::run_avx512<K>(as...);
+        case isa::avx2:
+            return detail::run_avx2<K>(as...);
+        case isa::sse4_2:
+            return detail::run_sse4_2<K>(as...);
+#endif
+        default:
+            return K::template run<SCA_SIMD_BYTES>(as...);
+    }
+}
+
+// run kernel `K` compiled for the best instruction set the CPU supports
+template <typename K, typename... As>
+auto simd_dispatch(As... as) {
+    return detail::simd_run<K>(detail::simd_isa(), as...);
+}
+#endif
+
+// arithmetic types which have vector lanes, `long double` lanes are wider than 
+// any lane the kernels handle
+template <typename T>
+using is_simd_value = std::integral_constant<bool, 
+    std::is_arithmetic<T>::value && !std::is_same<std::remove_cv_t<T>, bool>::value && sizeof(T) <= 8>;
+
+// ----------------------------------------------------------------------------
+// parallel
+
+// fewest elements a worker thread is started for, smaller ranges cost more to 
+// hand to a thread than to process
+constexpr size_t parallel_grain = size_t(1) << 16;
+
+// count of workers to split `len` elements between, one per hardware thread 
+inline size_t parallel_workers(size_t len) {
+    const size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    return std::max<size_t>(1, std::min(threads, len / detail::parallel_grain));
+}
+
+// only random access containers are split, others are never walked to be sized
+template <typename C>
+size_t parallel_workers(C& c, std::true_type /* random access */) {
+    return detail::parallel_workers(detail::size(c, detail::has_size<C>()));
+}
+
+template <typename C>
+size_t parallel_workers(C&, std::false_type) {
+    return 1;
+}
+
+/*
+ * Call `f(w, lo, hi)` for every worker `w` with its contiguous range `[lo, hi)` 
+ * of `[0, len)`. Worker 0 runs on the calling thread and the others on their 
+ * own threads, which are joined before returning. The first exception thrown 
+ * by a worker is rethrown once every worker has finished, and a worker whose 
+ * thread cannot be started runs on the calling thread instead.
+ */
+template <typename F>
+void parallel_for(size_t workers, size_t len, F&& f) {
+    std::vector<std::exception_ptr> errors(workers);
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+
+    auto run = [&](size_t w) {
+        try {
+            f(w, len * w / workers, len * (w + 1) / workers);
+        } catch(...) {
+            errors[w] = std::current_exception();
+        }
+    };
+
+    for(size_t w = 1; w < workers; ++w) {
+        try {
+            threads.emplace_back(run, w);
+        } catch(const std::system_error&) {
+            run(w);
+        }
+    }
+
+    run(0);
+
+    for(auto& t : threads) {
+        t.join();
+    }
+
+    for(auto& e : errors) {
+        if(e) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+// map standard library operator functors to their element-wise operations
+template <typename F, typename T>
+struct simd_op_struct {
+    typedef void type;
+};
+
+template <typename U, typename T>
+struct simd_op_struct<std::plus<U>, T> { typedef add_op type; };
+
+template <typename U, typename T>
+struct simd_op_struct<std::minus<U>, T> { typedef sub_op type; };
+
+template <typename U, typename T>
+struct simd_op_struct<std::multiplies<U>, T> { typedef mul_op type; };
+
+// there is no integer vector division instruction
+template <typename U, typename T>
+struct simd_op_struct<std::divides<U>, T> { 
+    typedef std::conditional_t<std::is_floating_point<T>::value, div_op, void> type; 
+};
+
+template <typename U, typename T>
+struct simd_op_struct<std::bit_and<U>, T> { 
+    typedef std::conditional_t<std::is_integral<T>::value, and_op, void> type; 
+};
+
+template <typename U, typename T>
+struct simd_op_struct<std::bit_or<U>, T> { 
+    typedef std::conditional_t<std::is_integral<T>::value, or_op, void> type; 
+};
+
+template <typename U, typename T>
+struct simd_op_struct<std::bit_xor<U>, T> { 
+    typedef std::conditional_t<std::is_integral<T>::value, xor_op, void> type; 
+};
+
+// the element-wise operation equivalent to functor `F` applied to `T`s, else `void`
+template <typename F, typename T>
+using simd_op_t = typename simd_op_struct<std::decay_t<F>, std::remove_cv_t<T>>::type;
+
 // ----------------------------------------------------------------------------- 
 // transfer  
 
@@ -147,6 +760,34 @@ void range_transfer(std::false_type, DIT&& dst_cur, IT&& src_cur, IT&& src_end)
     }
 }
 
+// ----------------------------------------------------------------------------- 
+// push 
+
+// Copy or move only one value to the back of a container
+template <typename R, typename V>
+void push(std::true_type, R& ret, V& v) {
+    ret.push_back(v);
+}
+
+template <typename R, typename V>
+void push(std::false_type, R& ret, V& v) {
+    ret.push_back(std::move(v));
+}
+
+// ----------------------------------------------------------------------------- 
+// assign 
+
+// Copy or move only one value over an existing element
+template <typename E, typename V>
+void assign(std::true_type, E& e, V& v) {
+    e = v;
+}
+
+template <typename E, typename V>
+void assign(std::false_type, E& e, V& v) {
+    e = std::move(v);
+}
+
 // ----------------------------------------------------------------------------- 
 // values 
 
@@ -217,47 +858,653 @@ void advance_group(IT& it, IT2& it2, ITs&... its) {
 
 // ----------------------------------------------------------------------------- 
 // map
+
+/*
+ * When every iterator is random access, iterate with a single index instead 
+ * of stepping each iterator. Compilers vectorize this form far more readily.
+ */
 template <typename F, typename RIT, typename IT, typename... ITs>
-void map(F&& f, RIT&& rit, IT&& it, IT&& it_end, ITs&&... its) {
+void map_loop(std::true_type, F& f, RIT& rit, IT& it, IT& it_end, ITs&... its) {
+    const size_t len = it_end - it;
+
+    for(size_t i = 0; i < len; ++i) {
+        rit[i] = f(it[i], its[i]...);
+    }
+}
+
+template <typename F, typename RIT, typename IT, typename... ITs>
+void map_loop(std::false_type, F& f, RIT& rit, IT& it, IT& it_end, ITs&... its) {
     while(it != it_end) {
         *rit = f(*it, *its...);
         advance_group(rit, it, its...);
     }
 }
 
-// ----------------------------------------------------------------------------
-// fold
-template <typename F, 
-          typename R,
-          typename IT,
-          typename... ITs>
-std::decay_t<R>
-fold(F& f, R&& init, IT&& it, IT&& it_end, ITs&&... its) {
-    std::decay_t<R> mutable_state(std::forward<R>(init));
+/*
+ * `std::true_type` when `sca::map()` is applying a standard operator functor 
+ * (`std::plus<>`, `std::multiplies<>`, etc.) to two contiguous containers of 
+ * the same arithmetic type, producing that type.
+ */
+template <typename F, typename RIT, typename IT, typename... ITs>
+struct is_simd_map_struct {
+    static const bool is = false;
+};
 
-    while(it != it_end) {
-        mutable_state = f(std::move(mutable_state), *it, *its...);
-        advance_group(it, its...);
+template <typename F, typename T, typename U, typename U2>
+struct is_simd_map_struct<F, T*, U*, U2*> {
+    static const bool is = SCA_SIMD && 
+        detail::is_simd_value<T>::value &&
+        std::is_same<T, std::remove_const_t<U>>::value &&
+        std::is_same<T, std::remove_const_t<U2>>::value &&
+        !std::is_void<detail::simd_op_t<F, T>>::value;
+};
+
+template <typename F, typename RIT, typename IT, typename... ITs>
+using is_simd_map_t = std::integral_constant<bool, 
+    detail::is_simd_map_struct<F, std::decay_t<RIT>, std::decay_t<IT>, std::decay_t<ITs>...>::is>;
+
+#if SCA_SIMD
+// apply `OP` a full vector at a time, finishing the remainder with scalars
+struct map_kernel {
+    template <size_t BYTES, typename OP, typename T>
+    static SCA_ALWAYS_INLINE void run(OP op, T* out, const T* a, const T* b, size_t len) {
+        typedef detail::vector_of<T, BYTES> VO;
+        typedef typename VO::type V;
+        size_t i = 0;
+
+        for(; i + VO::lanes <= len; i += VO::lanes) {
+            V va;
+            V vb;
+            detail::load(va, a + i);
+            detail::load(vb, b + i);
+            op(va, va, vb);
+            detail::store(out + i, va);
+        }
+
+        for(; i < len; ++i) {
+            out[i] = op(a[i], b[i]);
+        }
     }
+};
 
-    return mutable_state;
+template <typename F, typename RIT, typename IT, typename IT2>
+void map_simd(std::true_type, F& /* f */, RIT& rit, IT& it, IT& it_end, IT2& it2) {
+    typedef std::remove_pointer_t<RIT> T;
+    detail::simd_dispatch<detail::map_kernel>(detail::simd_op_t<F, T>(), rit, it, it2, size_t(it_end - it));
 }
+#endif
 
-// ----------------------------------------------------------------------------- 
-// each
-template <typename F, typename IT, typename... ITs>
-void each(F&& f, IT&& it, IT&& it_end, ITs&&... its) {
-    while(it != it_end) {
-        f(*it, *its...);
-        advance_group(it, its...);
-    }
+template <typename F, typename RIT, typename IT, typename... ITs>
+void map_simd(std::false_type, F& f, RIT& rit, IT& it, IT& it_end, ITs&... its) {
+    detail::map_loop(detail::is_random_access_t<RIT, IT, ITs...>(), f, rit, it, it_end, its...);
 }
 
+template <typename F, typename RIT, typename IT, typename... ITs>
+void map(F&& f, RIT&& rit, IT&& it, IT&& it_end, ITs&&... its) {
+    detail::map_simd(detail::is_simd_map_t<F, RIT, IT, ITs...>(), f, rit, it, it_end, its...);
+}
+
+// ----------------------------------------------------------------------------- 
+// map_into
+
+// the size of the result is known ahead of time, so assign results in place
+template <typename R, typename F, typename C, typename... Cs>
+void map_into(std::false_type, R& ret, F&& f, C& c, Cs&... cs) {
+    ret.resize(detail::size(c, detail::has_size<C>()));
+    detail::map(std::forward<F>(f), detail::begin(ret), detail::begin(c), detail::end(c), detail::begin(cs)...);
+}
+
+// a single pass container is consumed by measuring it, so grow the result instead
+template <typename R, typename F, typename C, typename... Cs>
+void map_into(std::true_type, R& ret, F&& f, C& c, Cs&... cs) {
+    detail::map(std::forward<F>(f), std::back_inserter(ret), c.begin(), c.end(), cs.begin()...);
+}
+
+// ----------------------------------------------------------------------------- 
+// compare_to
+
+/// predicate comparing its argument to a stored value with comparison `OP`
+template <typename OP, typename T>
+struct compare_to {
+    T value;
+
+    template <typename U>
+    bool operator()(const U& u) const {
+        return OP()(u, value);
+    }
+};
+
+// ----------------------------------------------------------------------------- 
+// filter
+
+/*
+ * `std::true_type` when predicate `F` is a `compare_to` of arithmetic values, 
+ * and comparing it with arithmetic type `T` would be performed in type `T` 
+ * anyway. 
+ */
+template <typename F, typename T>
+struct is_simd_compare_struct {
+    static const bool is = false;
+};
+
+template <typename OP, typename U, typename T>
+struct is_simd_compare_struct<compare_to<OP, U>, T> {
+    static const bool is = SCA_SIMD && 
+        detail::is_simd_value<T>::value && 
+        detail::is_simd_value<U>::value && 
+        std::is_same<T, std::common_type_t<T, U>>::value;
+};
+
+template <typename F, typename T>
+using is_simd_compare_t = std::integral_constant<bool, 
+    detail::is_simd_compare_struct<std::decay_t<F>, std::remove_cv_t<T>>::is>;
+
+// `std::true_type` when `sca::filter()` can compact a contiguous container with vector kernels
+template <typename F, typename C>
+using is_simd_filter_t = std::integral_constant<bool, 
+    detail::has_data<C>::value && 
+    detail::is_simd_compare_t<F, typename std::decay_t<C>::value_type>::value>;
+
+#if SCA_SIMD_SHUFFLE
+/*
+ * Byte shuffle indices which move the selected lanes of a 16 byte piece of a 
+ * vector to its front, and the count of selected lanes, indexed by a bitmask 
+ * of the selected lanes. The count is stored because the instruction sets 
+ * kernels are dispatched to do not include popcnt. Pieces of single byte 
+ * lanes are compacted 8 lanes at a time to keep the table small.
+ */
+template <size_t S>
+struct compact_entries {
+    static const size_t lanes = S == 1 ? 8 : 16 / S;
+    char idx[size_t(1) << lanes][16];
+    unsigned char count[size_t(1) << lanes];
+};
+
+template <size_t S>
+constexpr compact_entries<S> make_compact_entries() {
+    compact_entries<S> e{};
+
+    for(size_t m = 0; m < (size_t(1) << compact_entries<S>::lanes); ++m) {
+        size_t k = 0;
+
+        for(size_t l = 0; l < compact_entries<S>::lanes; ++l) {
+            if(m & (size_t(1) << l)) {
+                for(size_t b = 0; b < S; ++b) {
+                    e.idx[m][k * S + b] = char(l * S + b);
+                }
+
+                ++k;
+            }
+        }
+
+        e.count[m] = (unsigned char)k;
+    }
+
+    return e;
+}
+
+template <size_t S>
+struct compact_table {
+    static constexpr compact_entries<S> entries = detail::make_compact_entries<S>();
+};
+
+template <size_t S>
+constexpr compact_entries<S> compact_table<S>::entries;
+
+typedef vector_of<char, 16>::type bytes16;
+
+// one bit per lane of a 16 byte comparison mask, gathered from the first byte of each lane
+SCA_ALWAYS_INLINE uint32_t lane_bits(std::integral_constant<size_t, 1>, uint32_t b) {
+    return b;
+}
+
+SCA_ALWAYS_INLINE uint32_t lane_bits(std::integral_constant<size_t, 2>, uint32_t b) {
+    b &= 0x5555;
+    b = (b | (b >> 1)) & 0x3333;
+    b = (b | (b >> 2)) & 0x0F0F;
+    return (b | (b >> 4)) & 0x00FF;
+}
+
+SCA_ALWAYS_INLINE uint32_t lane_bits(std::integral_constant<size_t, 4>, uint32_t b) {
+    // the products of bits 0, 4, 8 and 12 never overlap, so they land on bits 9 to 12 without carries
+    return (((b & 0x1111) * 0x249) >> 9) & 0xF;
+}
+
+SCA_ALWAYS_INLINE uint32_t lane_bits(std::integral_constant<size_t, 8>, uint32_t b) {
+    b &= 0x0101;
+    return (b | (b >> 7)) & 0x3;
+}
+
+template <size_t S>
+SCA_ALWAYS_INLINE uint32_t lane_bits(const bytes16& m) {
+    return detail::lane_bits(std::integral_constant<size_t, S>(), detail::byte_lane_bits(m));
+}
+
+// store the lanes of a 16 byte piece selected by `bits` contiguously at `out`, returning their count
+template <typename T>
+SCA_ALWAYS_INLINE size_t compact_piece(std::false_type /* byte lanes */, const bytes16& v, uint32_t bits, T* out) {
+    bytes16 idx;
+    detail::load(idx, compact_table<sizeof(T)>::entries.idx[bits]);
+    detail::store(out, __builtin_shuffle(v, idx));
+    return compact_table<sizeof(T)>::entries.count[bits];
+}
+
+template <typename T>
+SCA_ALWAYS_INLINE size_t compact_piece(std::true_type /* byte lanes */, const bytes16& v, uint32_t bits, T* out) {
+    const uint32_t lo_bits = bits & 0xFF;
+    const uint32_t hi_bits = bits >> 8;
+    bytes16 lo_idx;
+    bytes16 hi_idx;
+    detail::load(lo_idx, compact_table<1>::entries.idx[lo_bits]);
+    detail::load(hi_idx, compact_table<1>::entries.idx[hi_bits]);
+    const bytes16 lo = __builtin_shuffle(v, lo_idx);
+    const bytes16 hi = __builtin_shuffle(v, hi_idx + char(8));
+    const size_t lo_count = compact_table<1>::entries.count[lo_bits];
+    std::memcpy(out, &lo, 8);
+    std::memcpy(out + lo_count, &hi, 8);
+    return lo_count + compact_table<1>::entries.count[hi_bits];
+}
+
+/*
+ * Store the lanes of `v` selected by comparison mask `m` contiguously at 
+ * `out`, 16 bytes at a time, returning their count. Every store stays within 
+ * the bytes of `v`'s own position in a compacted buffer. 
+ */
+template <size_t BYTES, typename T, typename V, typename M>
+SCA_ALWAYS_INLINE size_t compact(const V& v, const M& m, T* out) {
+    size_t count = 0;
+
+    for(size_t k = 0; k < BYTES; k += 16) {
+        bytes16 pv;
+        bytes16 pm;
+        std::memcpy(&pv, reinterpret_cast<const char*>(&v) + k, 16);
+        std::memcpy(&pm, reinterpret_cast<const char*>(&m) + k, 16);
+        count += detail::compact_piece<T>(std::integral_constant<bool, sizeof(T) == 1>(), 
+                                          pv, detail::lane_bits<sizeof(T)>(pm), out + count);
+    }
+
+    return count;
+}
+#endif
+
+#if SCA_SIMD_COMPRESS
+typedef int v16si __attribute__((vector_size(64)));
+typedef long long v8di __attribute__((vector_size(64)));
+
+// store the lanes of `v` selected by comparison mask `m` contiguously at `out`, returning their count
+__attribute__((target("avx512f"))) 
+SCA_ALWAYS_INLINE size_t compress_store(const v16si& v, const v16si& m, void* out) {
+    const unsigned short bits = __builtin_ia32_ptestmd512(m, m, 0xFFFF);
+    __builtin_ia32_compressstoresi512_mask(static_cast<v16si*>(out), v, bits);
+    return size_t(__builtin_popcount(bits));
+}
+
+__attribute__((target("avx512f"))) 
+SCA_ALWAYS_INLINE size_t compress_store(const v8di& v, const v8di& m, void* out) {
+    const unsigned char bits = __builtin_ia32_ptestmq512(m, m, 0xFF);
+    __builtin_ia32_compressstoredi512_mask(static_cast<v8di*>(out), v, bits);
+    return size_t(__builtin_popcount(bits));
+}
+
+/*
+ * AVX-512 filter of 4 and 8 byte lanes, compacting every vector with a single 
+ * compress store. Compress instructions cannot be reached from the generic, 
+ * inlined kernel code, so this is called out of line from `filter_kernel`.
+ */
+template <typename OP, typename T>
+__attribute__((target("avx512f"))) 
+size_t filter_compress(OP op, T value, const T* p, size_t len, T* out) {
+    typedef detail::vector_of<T, 64> VO;
+    typedef typename VO::type V;
+    typedef std::conditional_t<sizeof(T) == 4, v16si, v8di> IV;
+    const size_t lanes = VO::lanes;
+    V vvalue;
+    detail::broadcast(vvalue, value);
+    size_t cur = 0;
+    size_t i = 0;
+
+    for(; i + lanes <= len; i += lanes) {
+        V v;
+        typename VO::mask mask;
+        detail::load(v, p + i);
+        op(mask, v, vvalue);
+        cur += detail::compress_store((IV)v, (IV)mask, out + cur);
+    }
+
+    for(; i < len; ++i) {
+        out[cur] = p[i];
+        cur += op(p[i], value);
+    }
+
+    return cur;
+}
+#endif
+
+#if SCA_SIMD
+/*
+ * Compact the elements matching `op(element, value)` into `out`, which must 
+ * have room for `len` elements. Vectors where no lanes or all lanes match are 
+ * skipped or stored whole, others are compacted with a shuffle table where 
+ * available. Elements which do not fill a vector are written to `out` and the 
+ * output cursor advances by the comparison result, so there is no branch to 
+ * mispredict per element. 
+ */
+struct filter_kernel {
+    template <size_t BYTES, typename OP, typename T>
+    static SCA_ALWAYS_INLINE size_t run(OP op, T value, const T* p, size_t len, T* out) {
+        typedef std::integral_constant<bool, SCA_SIMD_COMPRESS && BYTES == 64 && sizeof(T) >= 4> IS_COMPRESS;
+        return run<BYTES>(IS_COMPRESS(), op, value, p, len, out);
+    }
+
+#if SCA_SIMD_COMPRESS
+    template <size_t BYTES, typename OP, typename T>
+    static SCA_ALWAYS_INLINE size_t run(std::true_type /* compress */, OP op, T value, const T* p, size_t len, T* out) {
+        return detail::filter_compress(op, value, p, len, out);
+    }
+#endif
+
+    template <size_t BYTES, typename OP, typename T>
+    static SCA_ALWAYS_INLINE size_t run(std::false_type, OP op, T value, const T* p, size_t len, T* out) {
+        typedef detail::vector_of<T, BYTES> VO;
+        typedef typename VO::type V;
+        const size_t lanes = VO::lanes;
+        V vvalue;
+        detail::broadcast(vvalue, value);
+        const size_t vlen = len - len % lanes;
+        size_t cur = 0;
+        size_t i = 0;
+
+        for(; i < vlen; i += lanes) {
+            V v;
+            typename VO::mask mask;
+            detail::load(v, p + i);
+            op(mask, v, vvalue);
+
+            if(!detail::any_lane(mask)) {
+                continue;
+            } else if(detail::all_lanes(mask)) {
+                detail::store(out + cur, v);
+                cur += lanes;
+            } else {
+#if SCA_SIMD_SHUFFLE
+                cur += detail::compact<BYTES>(v, mask, out + cur);
+#else
+                for(size_t l = 0; l < lanes; ++l) {
+                    out[cur] = p[i + l];
+                    cur += mask[l] != 0;
+                }
+#endif
+            }
+        }
+
+        for(; i < len; ++i) {
+            out[cur] = p[i];
+            cur += op(p[i], value);
+        }
+
+        return cur;
+    }
+};
+
+template <typename LVALUE, typename R, typename OP, typename U, typename C>
+void filter_simd(std::true_type, LVALUE, R& ret, const compare_to<OP, U>& f, C& c) {
+    typedef typename std::decay_t<C>::value_type T;
+    ret.resize(c.size());
+    ret.resize(detail::simd_dispatch<detail::filter_kernel>(OP(), static_cast<T>(f.value), c.data(), c.size(), ret.data()));
+}
+#endif
+
+template <typename LVALUE, typename R, typename F, typename C>
+void filter_simd(std::false_type, LVALUE, R& ret, F&& f, C& c) {
+    ret.resize(detail::size(c, detail::has_size<C>()));
+    size_t cur = 0;
+
+    for(auto&& e : c) {
+        if(f(e)) {
+            detail::transfer(LVALUE(), ret[cur], e);
+            ++cur;
+        }
+    }
+
+    ret.resize(cur);
+}
+
+template <typename LVALUE, typename R, typename F, typename C>
+void filter(std::false_type, LVALUE, R& ret, F&& f, C& c) {
+    detail::filter_simd(detail::is_simd_filter_t<F, C>(), LVALUE(), ret, f, c);
+}
+
+// single pass containers cannot be measured ahead of time
+template <typename LVALUE, typename R, typename F, typename C>
+void filter(std::true_type, LVALUE, R& ret, F&& f, C& c) {
+    for(auto&& e : c) {
+        if(f(e)) {
+            detail::push(LVALUE(), ret, e);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// fold
+template <typename F, typename R, typename IT, typename... ITs>
+void fold_loop(std::true_type, F& f, R& mutable_state, IT& it, IT& it_end, ITs&... its) {
+    const size_t len = it_end - it;
+
+    for(size_t i = 0; i < len; ++i) {
+        mutable_state = f(std::move(mutable_state), it[i], its[i]...);
+    }
+}
+
+template <typename F, typename R, typename IT, typename... ITs>
+void fold_loop(std::false_type, F& f, R& mutable_state, IT& it, IT& it_end, ITs&... its) {
+    while(it != it_end) {
+        mutable_state = f(std::move(mutable_state), *it, *its...);
+        advance_group(it, its...);
+    }
+}
+
+template <typename F, 
+          typename R,
+          typename IT,
+          typename... ITs>
+std::decay_t<R>
+fold(F& f, R&& init, IT&& it, IT&& it_end, ITs&&... its) {
+    std::decay_t<R> mutable_state(std::forward<R>(init));
+    detail::fold_loop(detail::is_random_access_t<IT, ITs...>(), f, mutable_state, it, it_end, its...);
+    return mutable_state;
+}
+
+// ----------------------------------------------------------------------------
+// fold_into
+template <typename F, typename S, typename IT, typename... ITs>
+void fold_into_loop(std::true_type, F& f, S& state, IT& it, IT& it_end, ITs&... its) {
+    const size_t len = it_end - it;
+
+    for(size_t i = 0; i < len; ++i) {
+        f(state, it[i], its[i]...);
+    }
+}
+
+template <typename F, typename S, typename IT, typename... ITs>
+void fold_into_loop(std::false_type, F& f, S& state, IT& it, IT& it_end, ITs&... its) {
+    while(it != it_end) {
+        f(state, *it, *its...);
+        advance_group(it, its...);
+    }
+}
+
+template <typename F, typename S, typename IT, typename... ITs>
+std::decay_t<S>
+fold_into(F& f, S&& init, IT&& it, IT&& it_end, ITs&&... its) {
+    std::decay_t<S> state(std::forward<S>(init));
+    detail::fold_into_loop(detail::is_random_access_t<IT, ITs...>(), f, state, it, it_end, its...);
+    return state;
+}
+
+// ----------------------------------------------------------------------------
+// fold_while
+
+// update the state until the function's result stops being equal to `WHILE`
+template <bool WHILE, typename F, typename S, typename IT, typename... ITs>
+void fold_while_loop(std::true_type, F& f, S& state, IT& it, IT& it_end, ITs&... its) {
+    const size_t len = it_end - it;
+
+    for(size_t i = 0; i < len; ++i) {
+        if(bool(f(state, it[i], its[i]...)) != WHILE) {
+            return;
+        }
+    }
+}
+
+template <bool WHILE, typename F, typename S, typename IT, typename... ITs>
+void fold_while_loop(std::false_type, F& f, S& state, IT& it, IT& it_end, ITs&... its) {
+    while(it != it_end) {
+        if(bool(f(state, *it, *its...)) != WHILE) {
+            return;
+        }
+
+        advance_group(it, its...);
+    }
+}
+
+template <bool WHILE, typename F, typename S, typename IT, typename... ITs>
+std::decay_t<S>
+fold_while(F& f, S&& init, IT&& it, IT&& it_end, ITs&&... its) {
+    std::decay_t<S> state(std::forward<S>(init));
+    detail::fold_while_loop<WHILE>(detail::is_random_access_t<IT, ITs...>(), f, state, it, it_end, its...);
+    return state;
+}
+
+// ----------------------------------------------------------------------------- 
+// each
+template <typename F, typename IT, typename... ITs>
+void each_loop(std::true_type, F& f, IT& it, IT& it_end, ITs&... its) {
+    const size_t len = it_end - it;
+
+    for(size_t i = 0; i < len; ++i) {
+        f(it[i], its[i]...);
+    }
+}
+
+template <typename F, typename IT, typename... ITs>
+void each_loop(std::false_type, F& f, IT& it, IT& it_end, ITs&... its) {
+    while(it != it_end) {
+        f(*it, *its...);
+        advance_group(it, its...);
+    }
+}
+
+template <typename F, typename IT, typename... ITs>
+void each(F&& f, IT&& it, IT&& it_end, ITs&&... its) {
+    detail::each_loop(detail::is_random_access_t<IT, ITs...>(), f, it, it_end, its...);
+}
+
+// ----------------------------------------------------------------------------
+// scan
+
+// `std::true_type` when `sca::all()` or `sca::some()` can test a single contiguous container with vector kernels
+template <typename F, typename IT, typename... ITs>
+struct is_simd_scan_struct {
+    static const bool is = false;
+};
+
+template <typename F, typename T>
+struct is_simd_scan_struct<F, T*> {
+    static const bool is = detail::is_simd_compare_t<F, T>::value;
+};
+
+template <typename F, typename IT, typename... ITs>
+using is_simd_scan_t = std::integral_constant<bool, 
+    detail::is_simd_scan_struct<F, std::decay_t<IT>, std::decay_t<ITs>...>::is>;
+
+#if SCA_SIMD
+/*
+ * Test several vectors per block and only branch once per block, so the scan 
+ * exits early at block granularity. When `ALL` is `true` the scan stops at 
+ * the first element failing `op(element, value)`, otherwise it stops at the 
+ * first element passing it. Returns the result `sca::all()` or `sca::some()` 
+ * should return.
+ */
+template <bool ALL>
+struct scan_kernel {
+    template <size_t BYTES, typename OP, typename T>
+    static SCA_ALWAYS_INLINE bool run(OP op, T value, const T* p, size_t len) {
+        typedef detail::vector_of<T, BYTES> VO;
+        typedef typename VO::type V;
+        const size_t lanes = VO::lanes;
+        typedef typename VO::mask M;
+        V vvalue;
+        detail::broadcast(vvalue, value);
+        const size_t blen = len - len % (4 * lanes);
+        const size_t vlen = len - len % lanes;
+        size_t i = 0;
+
+        for(; i < blen; i += 4 * lanes) {
+            V v0;
+            V v1;
+            V v2;
+            V v3;
+            M m0;
+            M m1;
+            M m2;
+            M m3;
+            detail::load(v0, p + i);
+            detail::load(v1, p + i + lanes);
+            detail::load(v2, p + i + 2 * lanes);
+            detail::load(v3, p + i + 3 * lanes);
+            op(m0, v0, vvalue);
+            op(m1, v1, vvalue);
+            op(m2, v2, vvalue);
+            op(m3, v3, vvalue);
+
+            if(ALL ? !detail::all_lanes(m0 & m1 & m2 & m3) : detail::any_lane(m0 | m1 | m2 | m3)) {
+                return !ALL;
+            }
+        }
+
+        for(; i < vlen; i += lanes) {
+            V v;
+            M m;
+            detail::load(v, p + i);
+            op(m, v, vvalue);
+
+            if(ALL ? !detail::all_lanes(m) : detail::any_lane(m)) {
+                return !ALL;
+            }
+        }
+
+        for(; i < len; ++i) {
+            if(op(p[i], value) != ALL) {
+                return !ALL;
+            }
+        }
+
+        return ALL;
+    }
+};
+#endif
+
 // ----------------------------------------------------------------------------
 // all
 template <typename F, typename IT, typename... ITs>
 bool
-all(F&& f, IT&& it, IT&& it_end, ITs&&... its) {
+all_loop(std::true_type, F& f, IT& it, IT& it_end, ITs&... its) {
+    bool ret = true;
+    const size_t len = it_end - it;
+
+    for(size_t i = 0; i < len; ++i) {
+        if(!f(it[i], its[i]...)) {
+            ret = false;
+            break;
+        }
+    }
+
+    return ret;
+}
+
+template <typename F, typename IT, typename... ITs>
+bool
+all_loop(std::false_type, F& f, IT& it, IT& it_end, ITs&... its) {
     bool ret = true;
 
     while(it != it_end) {
@@ -272,11 +1519,48 @@ all(F&& f, IT&& it, IT&& it_end, ITs&&... its) {
     return ret;
 }
 
+template <typename F, typename IT, typename... ITs>
+bool
+all_simd(std::false_type, F& f, IT& it, IT& it_end, ITs&... its) {
+    return detail::all_loop(detail::is_random_access_t<IT, ITs...>(), f, it, it_end, its...);
+}
+
+#if SCA_SIMD
+template <typename OP, typename U, typename T>
+bool
+all_simd(std::true_type, const compare_to<OP, U>& f, T* it, T* it_end) {
+    typedef std::remove_const_t<T> V;
+    return detail::simd_dispatch<detail::scan_kernel<true>>(OP(), static_cast<V>(f.value), it, size_t(it_end - it));
+}
+#endif
+
+template <typename F, typename IT, typename... ITs>
+bool
+all(F&& f, IT&& it, IT&& it_end, ITs&&... its) {
+    return detail::all_simd(detail::is_simd_scan_t<F, IT, ITs...>(), f, it, it_end, its...);
+}
+
 // ----------------------------------------------------------------------------
 // some
 template <typename F, typename IT, typename... ITs>
 bool
-some(F&& f, IT&& it, IT&& it_end, ITs&&... its) {
+some_loop(std::true_type, F& f, IT& it, IT& it_end, ITs&... its) {
+    bool ret = false;
+    const size_t len = it_end - it;
+
+    for(size_t i = 0; i < len; ++i) {
+        if(f(it[i], its[i]...)) {
+            ret = true;
+            break;
+        }
+    }
+
+    return ret;
+}
+
+template <typename F, typename IT, typename... ITs>
+bool
+some_loop(std::false_type, F& f, IT& it, IT& it_end, ITs&... its) {
     bool ret = false;
 
     while(it != it_end) {
@@ -291,333 +1575,4239 @@ some(F&& f, IT&& it, IT&& it_end, ITs&&... its) {
     return ret;
 }
 
+template <typename F, typename IT, typename... ITs>
+bool
+some_simd(std::false_type, F& f, IT& it, IT& it_end, ITs&... its) {
+    return detail::some_loop(detail::is_random_access_t<IT, ITs...>(), f, it, it_end, its...);
 }
 
-//------------------------------------------------------------------------------
+#if SCA_SIMD
+template <typename OP, typename U, typename T>
+bool
+some_simd(std::true_type, const compare_to<OP, U>& f, T* it, T* it_end) {
+    typedef std::remove_const_t<T> V;
+    return detail::simd_dispatch<detail::scan_kernel<false>>(OP(), static_cast<V>(f.value), it, size_t(it_end - it));
+}
+#endif
+
+template <typename F, typename IT, typename... ITs>
+bool
+some(F&& f, IT&& it, IT&& it_end, ITs&&... its) {
+    return detail::some_simd(detail::is_simd_scan_t<F, IT, ITs...>(), f, it, it_end, its...);
+}
+
+// ----------------------------------------------------------------------------
+// reduce 
+
+// value which is never smaller than any other value of type `T`
+template <typename T>
+T highest(std::true_type /* has infinity */) {
+    return std::numeric_limits<T>::infinity();
+}
+
+template <typename T>
+T highest(std::false_type) {
+    return std::numeric_limits<T>::max();
+}
+
+// value which is never larger than any other value of type `T`
+template <typename T>
+T lowest(std::true_type /* has infinity */) {
+    return -std::numeric_limits<T>::infinity();
+}
+
+template <typename T>
+T lowest(std::false_type) {
+    return std::numeric_limits<T>::lowest();
+}
+
+// the value which leaves any other value unchanged when combined by an operation
+template <typename T>
+T identity(add_op) {
+    return T();
+}
+
+template <typename T>
+T identity(min_op) {
+    static_assert(std::is_arithmetic<T>::value, "only arithmetic types have a largest value");
+    return detail::highest<T>(std::integral_constant<bool, std::numeric_limits<T>::has_infinity>());
+}
+
+template <typename T>
+T identity(max_op) {
+    static_assert(std::is_arithmetic<T>::value, "only arithmetic types have a lowest value");
+    return detail::lowest<T>(std::integral_constant<bool, std::numeric_limits<T>::has_infinity>());
+}
+
+// the result of reducing an empty container, a value initialized element for non-arithmetic types
+template <typename T, typename OP>
+T empty_reduce(std::true_type /* is arithmetic */, OP op) {
+    return detail::identity<T>(op);
+}
+
+template <typename T, typename OP>
+T empty_reduce(std::false_type, OP) {
+    return T();
+}
+
+// integers are summed in 64 bits of the same signedness so that narrow elements do not wrap
+template <typename OP, typename T>
+using reduce_value_t = std::conditional_t<
+    std::is_same<OP, add_op>::value && std::is_integral<T>::value,
+    std::conditional_t<std::is_signed<T>::value, int64_t, uint64_t>,
+    T>;
+
+// `std::true_type` if reducing `T`s with `OP` has to widen them first
+template <typename OP, typename T>
+using is_widening_reduce_t = std::integral_constant<bool, 
+    sizeof(detail::reduce_value_t<OP, T>) != sizeof(T)>;
+
+// convert an element to the reduction's value type, arithmetic elements only
+template <typename R, typename X>
+R widen(std::true_type /* is arithmetic */, const X& x) {
+    return R(x);
+}
+
+template <typename R, typename X>
+const X& widen(std::false_type, const X& x) {
+    return x;
+}
+
+/*
+ * `std::true_type` if reducing container `C` can use vector kernels. Integer 
+ * arithmetic is associative, but floating point arithmetic is only reordered 
+ * if the user explicitly allowed it because the result can change.
+ */
+template <typename C, typename REASSOCIATE>
+using is_simd_reduce_t = std::integral_constant<bool, 
+    SCA_SIMD &&
+    detail::has_data<C>::value && 
+    detail::is_simd_value<typename std::decay_t<C>::value_type>::value &&
+    (REASSOCIATE::value || std::is_integral<typename std::decay_t<C>::value_type>::value)>;
+
+#if SCA_SIMD
+/*
+ * Reductions use several independent vector accumulators so that consecutive 
+ * vector operations do not wait on each other's results.
+ */
+struct reduce_kernel {
+    template <size_t BYTES, typename OP, typename T>
+    static SCA_ALWAYS_INLINE T run(OP op, const T* p, size_t len) {
+        typedef detail::vector_of<T, BYTES> VO;
+        typedef typename VO::type V;
+        const size_t lanes = VO::lanes;
+        const T id = detail::identity<T>(op);
+        V acc0;
+        detail::broadcast(acc0, id);
+        V acc1 = acc0;
+        V acc2 = acc0;
+        V acc3 = acc0;
+        size_t i = 0;
+
+        for(; i + 4 * lanes <= len; i += 4 * lanes) {
+            V v0;
+            V v1;
+            V v2;
+            V v3;
+            detail::load(v0, p + i);
+            detail::load(v1, p + i + lanes);
+            detail::load(v2, p + i + 2 * lanes);
+            detail::load(v3, p + i + 3 * lanes);
+            op(acc0, acc0, v0);
+            op(acc1, acc1, v1);
+            op(acc2, acc2, v2);
+            op(acc3, acc3, v3);
+        }
+
+        for(; i + lanes <= len; i += lanes) {
+            V v0;
+            detail::load(v0, p + i);
+            op(acc0, acc0, v0);
+        }
+
+        op(acc0, acc0, acc1);
+        op(acc2, acc2, acc3);
+        op(acc0, acc0, acc2);
+        T ret = id;
+
+        for(size_t l = 0; l < lanes; ++l) {
+            ret = op(ret, acc0[l]);
+        }
+
+        for(const T* end = p + len; p + i != end; ++i) {
+            ret = op(ret, p[i]);
+        }
+
+        return ret;
+    }
+};
+
+struct minmax_kernel {
+    template <size_t BYTES, typename T>
+    static SCA_ALWAYS_INLINE std::pair<T,T> run(const T* p, size_t len) {
+        typedef detail::vector_of<T, BYTES> VO;
+        typedef typename VO::type V;
+        const size_t lanes = VO::lanes;
+        const detail::min_op mn;
+        const detail::max_op mx;
+        V lo0;
+        V hi0;
+        detail::broadcast(lo0, detail::identity<T>(mn));
+        detail::broadcast(hi0, detail::identity<T>(mx));
+        V lo1 = lo0;
+        V hi1 = hi0;
+        size_t i = 0;
+
+        for(; i + 2 * lanes <= len; i += 2 * lanes) {
+            V v0;
+            V v1;
+            detail::load(v0, p + i);
+            detail::load(v1, p + i + lanes);
+            mn(lo0, lo0, v0);
+            mx(hi0, hi0, v0);
+            mn(lo1, lo1, v1);
+            mx(hi1, hi1, v1);
+        }
+
+        mn(lo0, lo0, lo1);
+        mx(hi0, hi0, hi1);
+        std::pair<T,T> ret(detail::identity<T>(mn), detail::identity<T>(mx));
+
+        for(size_t l = 0; l < lanes; ++l) {
+            ret.first = mn(ret.first, lo0[l]);
+            ret.second = mx(ret.second, hi0[l]);
+        }
+
+        for(; i < len; ++i) {
+            ret.first = mn(ret.first, p[i]);
+            ret.second = mx(ret.second, p[i]);
+        }
+
+        return ret;
+    }
+};
+
+struct dot_kernel {
+    // `acc += a[0, lanes) * b[0, lanes)`
+    template <typename V, typename T>
+    static SCA_ALWAYS_INLINE void step(V& acc, const T* a, const T* b) {
+        V va;
+        V vb;
+        detail::load(va, a);
+        detail::load(vb, b);
+        acc += va * vb;
+    }
+
+    template <size_t BYTES, typename T>
+    static SCA_ALWAYS_INLINE T run(const T* a, const T* b, size_t len) {
+        typedef detail::vector_of<T, BYTES> VO;
+        typedef typename VO::type V;
+        const size_t lanes = VO::lanes;
+        V acc0;
+        detail::broadcast(acc0, T());
+        V acc1 = acc0;
+        V acc2 = acc0;
+        V acc3 = acc0;
+        size_t i = 0;
+
+        for(; i + 4 * lanes <= len; i += 4 * lanes) {
+            step(acc0, a + i, b + i);
+            step(acc1, a + i + lanes, b + i + lanes);
+            step(acc2, a + i + 2 * lanes, b + i + 2 * lanes);
+            step(acc3, a + i + 3 * lanes, b + i + 3 * lanes);
+        }
+
+        for(; i + lanes <= len; i += lanes) {
+            step(acc0, a + i, b + i);
+        }
+
+        acc0 = (acc0 + acc1) + (acc2 + acc3);
+        T ret = T();
+
+        for(size_t l = 0; l < lanes; ++l) {
+            ret += acc0[l];
+        }
+
+        for(; i < len; ++i) {
+            ret += a[i] * b[i];
+        }
+
+        return ret;
+    }
+};
+
+// an integer type of `BYTES` bytes with the signedness of `T`
+template <size_t BYTES, bool SIGNED>
+struct int_of_struct;
+
+template <> struct int_of_struct<2, true> { typedef int16_t type; };
+template <> struct int_of_struct<2, false> { typedef uint16_t type; };
+template <> struct int_of_struct<4, true> { typedef int32_t type; };
+template <> struct int_of_struct<4, false> { typedef uint32_t type; };
+template <> struct int_of_struct<8, true> { typedef int64_t type; };
+template <> struct int_of_struct<8, false> { typedef uint64_t type; };
+
+template <typename T>
+using wider_t = typename int_of_struct<2 * sizeof(T), std::is_signed<T>::value>::type;
+
+/*
+ * Reinterpret a vector of integers as lanes twice as wide, and extract the 
+ * low or high half of each pair of narrow lanes, sign extended for signed 
+ * types. Shifts are available at every width on every instruction set, 
+ * unlike widening conversions of partial vectors.
+ */
+template <typename T, size_t BYTES>
+SCA_ALWAYS_INLINE void low_lanes(typename vector_of<wider_t<T>, BYTES>::type& r, 
+                                 const typename vector_of<T, BYTES>::type& v) {
+    typedef typename vector_of<wider_t<T>, BYTES>::type UV;
+    typedef typename vector_of<std::make_unsigned_t<wider_t<T>>, BYTES>::type UUV;
+    r = (UV)((UUV)v << (8 * sizeof(T))) >> (8 * sizeof(T));
+}
+
+template <typename T, size_t BYTES>
+SCA_ALWAYS_INLINE void high_lanes(typename vector_of<wider_t<T>, BYTES>::type& r, 
+                                  const typename vector_of<T, BYTES>::type& v) {
+    typedef typename vector_of<wider_t<T>, BYTES>::type UV;
+    r = (UV)v >> (8 * sizeof(T));
+}
+
+// sum adjacent lanes until they are 64 bits wide, which never overflows, and add them to `acc`
+template <typename T, size_t BYTES, typename RV>
+SCA_ALWAYS_INLINE void widen_lanes(std::true_type /* 64 bit */, RV& acc, const typename vector_of<T, BYTES>::type& v) {
+    acc += v;
+}
+
+template <typename T, size_t BYTES, typename RV>
+SCA_ALWAYS_INLINE void widen_lanes(std::false_type, RV& acc, const typename vector_of<T, BYTES>::type& v) {
+    typedef wider_t<T> U;
+    typename vector_of<U, BYTES>::type lo;
+    typename vector_of<U, BYTES>::type hi;
+    detail::low_lanes<T, BYTES>(lo, v);
+    detail::high_lanes<T, BYTES>(hi, v);
+    detail::widen_lanes<U, BYTES>(std::integral_constant<bool, sizeof(U) == 8>(), acc, lo + hi);
+}
+
+template <typename T, size_t BYTES, typename RV>
+SCA_ALWAYS_INLINE void widen_lanes(RV& acc, const typename vector_of<T, BYTES>::type& v) {
+    detail::widen_lanes<T, BYTES>(std::integral_constant<bool, sizeof(T) == 8>(), acc, v);
+}
+
+// integer sums and dot products of elements narrower than 64 bits
+struct widen_sum_kernel {
+    template <size_t BYTES, typename T>
+    static SCA_ALWAYS_INLINE reduce_value_t<add_op, T> run(const T* p, size_t len) {
+        typedef reduce_value_t<add_op, T> R;
+        typedef detail::vector_of<T, BYTES> VO;
+        typedef typename VO::type V;
+        typedef typename detail::vector_of<R, BYTES>::type RV;
+        const size_t lanes = VO::lanes;
+        RV acc0;
+        detail::broadcast(acc0, R());
+        RV acc1 = acc0;
+        size_t i = 0;
+
+        for(; i + 2 * lanes <= len; i += 2 * lanes) {
+            V v0;
+            V v1;
+            detail::load(v0, p + i);
+            detail::load(v1, p + i + lanes);
+            detail::widen_lanes<T, BYTES>(acc0, v0);
+            detail::widen_lanes<T, BYTES>(acc1, v1);
+        }
+
+        for(; i + lanes <= len; i += lanes) {
+            V v0;
+            detail::load(v0, p + i);
+            detail::widen_lanes<T, BYTES>(acc0, v0);
+        }
+
+        acc0 += acc1;
+        R ret = R();
+
+        for(size_t l = 0; l < BYTES / sizeof(R); ++l) {
+            ret += acc0[l];
+        }
+
+        for(; i < len; ++i) {
+            ret += R(p[i]);
+        }
+
+        return ret;
+    }
+};
+
+// the product of two lanes of `T` always fits in a lane twice as wide
+struct widen_dot_kernel {
+    template <size_t BYTES, typename T>
+    static SCA_ALWAYS_INLINE reduce_value_t<add_op, T> run(const T* a, const T* b, size_t len) {
+        typedef reduce_value_t<add_op, T> R;
+        typedef wider_t<T> U;
+        typedef detail::vector_of<T, BYTES> VO;
+        typedef typename VO::type V;
+        typedef typename detail::vector_of<R, BYTES>::type RV;
+        const size_t lanes = VO::lanes;
+        typedef typename detail::vector_of<U, BYTES>::type UV;
+        RV acc0;
+        detail::broadcast(acc0, R());
+        RV acc1 = acc0;
+        size_t i = 0;
+
+        for(; i + lanes <= len; i += lanes) {
+            V va;
+            V vb;
+            UV a_lo;
+            UV a_hi;
+            UV b_lo;
+            UV b_hi;
+            detail::load(va, a + i);
+            detail::load(vb, b + i);
+            detail::low_lanes<T, BYTES>(a_lo, va);
+            detail::high_lanes<T, BYTES>(a_hi, va);
+            detail::low_lanes<T, BYTES>(b_lo, vb);
+            detail::high_lanes<T, BYTES>(b_hi, vb);
+            detail::widen_lanes<U, BYTES>(acc0, a_lo * b_lo);
+            detail::widen_lanes<U, BYTES>(acc1, a_hi * b_hi);
+        }
+
+        acc0 += acc1;
+        R ret = R();
+
+        for(size_t l = 0; l < BYTES / sizeof(R); ++l) {
+            ret += acc0[l];
+        }
+
+        for(; i < len; ++i) {
+            ret += R(a[i]) * R(b[i]);
+        }
+
+        return ret;
+    }
+};
+
+template <typename OP, typename C>
+auto reduce_simd(std::false_type, OP op, C& c) {
+    return detail::simd_dispatch<detail::reduce_kernel>(op, c.data(), c.size());
+}
+
+template <typename C>
+auto reduce_simd(std::true_type /* widening */, add_op, C& c) {
+    return detail::simd_dispatch<detail::widen_sum_kernel>(c.data(), c.size());
+}
+
+// vectorized reduction of a contiguous container
+template <typename OP, typename C>
+auto reduce(std::true_type, OP op, C& c) {
+    typedef typename std::decay_t<C>::value_type T;
+    return detail::reduce_value_t<OP, T>(detail::reduce_simd(detail::is_widening_reduce_t<OP, T>(), op, c));
+}
+
+template <typename C>
+auto minmax(std::true_type, C& c) {
+    return detail::simd_dispatch<detail::minmax_kernel>(c.data(), c.size());
+}
+
+template <typename C, typename C2>
+auto dot_simd(std::false_type, C& c, C2& c2) {
+    return detail::simd_dispatch<detail::dot_kernel>(c.data(), c2.data(), c.size());
+}
+
+template <typename C, typename C2>
+auto dot_simd(std::true_type /* widening */, C& c, C2& c2) {
+    return detail::simd_dispatch<detail::widen_dot_kernel>(c.data(), c2.data(), c.size());
+}
+
+template <typename C, typename C2>
+auto dot(std::true_type, C& c, C2& c2) {
+    typedef typename std::decay_t<C>::value_type T;
+    return detail::reduce_value_t<add_op, T>(detail::dot_simd(detail::is_widening_reduce_t<add_op, T>(), c, c2));
+}
+#endif
+
+// ordered reduction, the same evaluation `sca::fold()` would perform
+template <typename OP, typename C>
+auto reduce(std::false_type, OP op, C& c) {
+    typedef typename std::decay_t<C>::value_type T;
+    typedef detail::reduce_value_t<OP, T> R;
+    const std::is_arithmetic<R> is_arithmetic;
+    auto it = c.begin();
+    auto end = c.end();
+
+    if(it == end) {
+        return detail::empty_reduce<R>(is_arithmetic, op);
+    }
+
+    R ret(*it);
+    ++it;
+
+    for(; it != end; ++it) {
+        ret = op(std::move(ret), detail::widen<R>(is_arithmetic, *it));
+    }
+
+    return ret;
+}
+
+template <typename C>
+auto minmax(std::false_type, C& c) {
+    typedef typename std::decay_t<C>::value_type T;
+    const detail::min_op mn;
+    const detail::max_op mx;
+    auto it = c.begin();
+    auto end = c.end();
+
+    if(it == end) {
+        const std::is_arithmetic<T> is_arithmetic;
+        return std::pair<T,T>(detail::empty_reduce<T>(is_arithmetic, mn), detail::empty_reduce<T>(is_arithmetic, mx));
+    }
+
+    std::pair<T,T> ret(*it, *it);
+    ++it;
+
+    for(; it != end; ++it) {
+        ret.first = mn(ret.first, *it);
+        ret.second = mx(ret.second, *it);
+    }
+
+    return ret;
+}
+
+template <typename C, typename C2>
+auto dot(std::false_type, C& c, C2& c2) {
+    typedef typename std::decay_t<C>::value_type T;
+    typedef detail::reduce_value_t<add_op, T> R;
+    typedef detail::reduce_value_t<add_op, typename std::decay_t<C2>::value_type> R2;
+    const std::is_arithmetic<R> is_arithmetic;
+    R ret = R();
+    auto it2 = c2.begin();
+
+    for(auto& e : c) {
+        ret = std::move(ret) + detail::widen<R>(is_arithmetic, e) * detail::widen<R2>(std::is_arithmetic<R2>(), *it2);
+        ++it2;
+    }
+
+    return ret;
+}
+
+// ----------------------------------------------------------------------------
+// map_fold
+
+template <typename F, typename G, typename R, typename IT, typename... ITs>
+void map_fold_loop(std::true_type, F& f, G& g, R& mutable_state, IT& it, IT& it_end, ITs&... its) {
+    const size_t len = it_end - it;
+
+    for(size_t i = 0; i < len; ++i) {
+        mutable_state = g(std::move(mutable_state), f(it[i], its[i]...));
+    }
+}
+
+template <typename F, typename G, typename R, typename IT, typename... ITs>
+void map_fold_loop(std::false_type, F& f, G& g, R& mutable_state, IT& it, IT& it_end, ITs&... its) {
+    while(it != it_end) {
+        mutable_state = g(std::move(mutable_state), f(*it, *its...));
+        advance_group(it, its...);
+    }
+}
+
+template <typename T>
+T identity(mul_op) {
+    return T(1);
+}
+
+template <typename T>
+T identity(and_op) {
+    return T(~T());
+}
+
+template <typename T>
+T identity(or_op) {
+    return T();
+}
+
+template <typename T>
+T identity(xor_op) {
+    return T();
+}
+
+// element-wise operations whose results can be combined in any order
+template <typename OP>
+using is_associative_op = std::integral_constant<bool, 
+    std::is_same<OP, add_op>::value ||
+    std::is_same<OP, mul_op>::value ||
+    std::is_same<OP, and_op>::value ||
+    std::is_same<OP, or_op>::value ||
+    std::is_same<OP, xor_op>::value>;
+
+/*
+ * `std::true_type` when `sca::map_fold()` is applying a standard operator 
+ * functor to two contiguous containers of the same arithmetic type and 
+ * reducing the results with an associative standard operator functor into a 
+ * value of that type. Both functors must also return that type, a typed 
+ * functor such as `std::divides<int>` converts its arguments and cannot be 
+ * computed in the containers' lanes. As with `reduce()`, floating point 
+ * results are only reordered if the user explicitly allowed it.
+ */
+template <typename F, typename G, typename R, typename REASSOCIATE, typename... Cs>
+struct is_simd_map_fold_struct {
+    static const bool is = false;
+};
+
+// the return types are only computed for standard operator functors, which are callable with any `T`s
+template <bool IS_OP, typename F, typename G, typename R, typename T>
+struct is_simd_map_fold_return {
+    static const bool is = false;
+};
+
+template <typename F, typename G, typename R, typename T>
+struct is_simd_map_fold_return<true, F, G, R, T> {
+    static const bool is = 
+        std::is_same<T, std::decay_t<detail::callable_return_t<F, T, T>>>::value &&
+        std::is_same<T, std::decay_t<detail::callable_return_t<G, R, T>>>::value;
+};
+
+template <typename F, typename G, typename R, typename REASSOCIATE, typename C, typename C2>
+struct is_simd_map_fold_struct<F, G, R, REASSOCIATE, C, C2> {
+    typedef typename std::decay_t<C>::value_type T;
+    static const bool is_op = SCA_SIMD &&
+        detail::has_data<C>::value && 
+        detail::has_data<C2>::value && 
+        detail::is_simd_value<T>::value &&
+        std::is_same<T, typename std::decay_t<C2>::value_type>::value &&
+        std::is_same<T, std::decay_t<R>>::value &&
+        !std::is_void<detail::simd_op_t<F, T>>::value &&
+        detail::is_associative_op<detail::simd_op_t<G, T>>::value &&
+        (REASSOCIATE::value || std::is_integral<T>::value);
+    static const bool is = detail::is_simd_map_fold_return<is_op, F, G, R, T>::is;
+};
+
+template <typename F, typename G, typename R, typename REASSOCIATE, typename... Cs>
+using is_simd_map_fold_t = std::integral_constant<bool, 
+    detail::is_simd_map_fold_struct<F, G, R, REASSOCIATE, Cs...>::is>;
+
+#if SCA_SIMD
+struct map_fold_kernel {
+    // `acc = rop(acc, op(a[0, lanes), b[0, lanes)))`
+    template <typename OP, typename ROP, typename V, typename T>
+    static SCA_ALWAYS_INLINE void step(OP op, ROP rop, V& acc, const T* a, const T* b) {
+        V va;
+        V vb;
+        detail::load(va, a);
+        detail::load(vb, b);
+        op(va, va, vb);
+        rop(acc, acc, va);
+    }
+
+    template <size_t BYTES, typename OP, typename ROP, typename T>
+    static SCA_ALWAYS_INLINE T run(OP op, ROP rop, const T* a, const T* b, size_t len) {
+        typedef detail::vector_of<T, BYTES> VO;
+        typedef typename VO::type V;
+        const size_t lanes = VO::lanes;
+        const T id = detail::identity<T>(rop);
+        V acc0;
+        detail::broadcast(acc0, id);
+        V acc1 = acc0;
+        V acc2 = acc0;
+        V acc3 = acc0;
+        size_t i = 0;
+
+        for(; i + 4 * lanes <= len; i += 4 * lanes) {
+            step(op, rop, acc0, a + i, b + i);
+            step(op, rop, acc1, a + i + lanes, b + i + lanes);
+            step(op, rop, acc2, a + i + 2 * lanes, b + i + 2 * lanes);
+            step(op, rop, acc3, a + i + 3 * lanes, b + i + 3 * lanes);
+        }
+
+        for(; i + lanes <= len; i += lanes) {
+            step(op, rop, acc0, a + i, b + i);
+        }
+
+        rop(acc0, acc0, acc1);
+        rop(acc2, acc2, acc3);
+        rop(acc0, acc0, acc2);
+        T ret = id;
+
+        for(size_t l = 0; l < lanes; ++l) {
+            ret = rop(ret, T(acc0[l]));
+        }
+
+        for(; i < len; ++i) {
+            ret = rop(ret, op(a[i], b[i]));
+        }
+
+        return ret;
+    }
+};
+
+// vectorized map and reduction of two contiguous containers
+template <typename F, typename G, typename R, typename C, typename C2>
+auto map_fold(std::true_type, F&, G&, R&& init, C& c, C2& c2) {
+    typedef typename std::decay_t<C>::value_type T;
+    const detail::simd_op_t<G, T> rop;
+    return rop(T(init), detail::simd_dispatch<detail::map_fold_kernel>(
+        detail::simd_op_t<F, T>(), rop, c.data(), c2.data(), c.size()));
+}
+#endif
+
+template <typename F, typename G, typename R, typename IT, typename... ITs>
+std::decay_t<R> map_fold_iterate(F& f, G& g, R&& init, IT&& it, IT&& it_end, ITs&&... its) {
+    std::decay_t<R> mutable_state(std::forward<R>(init));
+    detail::map_fold_loop(detail::is_random_access_t<IT, ITs...>(), f, g, mutable_state, it, it_end, its...);
+    return mutable_state;
+}
+
+// ordered evaluation, the same `sca::fold()` of the results of `sca::map()` would perform
+template <typename F, typename G, typename R, typename C, typename... Cs>
+std::decay_t<R> map_fold(std::false_type, F& f, G& g, R&& init, C& c, Cs&... cs) {
+    return detail::map_fold_iterate(f, g, std::forward<R>(init), detail::begin(c), detail::end(c), detail::begin(cs)...);
+}
+
+#if SCA_SIMD
+// vectorized partial result of the non-empty index range `[lo, hi)`
+template <typename S, typename F, typename G, typename T>
+S map_fold_range(std::true_type, F&, G&, size_t lo, size_t hi, const T* a, const T* b) {
+    return detail::simd_dispatch<detail::map_fold_kernel>(
+        detail::simd_op_t<F, T>(), detail::simd_op_t<G, T>(), a + lo, b + lo, hi - lo);
+}
+#endif
+
+// partial result of the non-empty index range `[lo, hi)`, started from its first result of `f`
+template <typename S, typename F, typename G, typename IT, typename... ITs>
+S map_fold_range(std::false_type, F& f, G& g, size_t lo, size_t hi, IT it, ITs... its) {
+    S mutable_state(f(it[lo], its[lo]...));
+
+    for(size_t i = lo + 1; i < hi; ++i) {
+        mutable_state = g(std::move(mutable_state), f(it[i], its[i]...));
+    }
+
+    return mutable_state;
+}
+
+/*
+ * Each worker reduces its own index range without `init`, then the partial 
+ * results are reduced with `g` in range order starting from `init`. Partial 
+ * results live behind pointers so an empty range has none, and `init` is 
+ * passed to `g` exactly once as in the sequential evaluation.
+ */
+template <typename SIMD, typename F, typename G, typename R, typename C, typename... Cs>
+std::decay_t<R> parallel_map_fold(std::true_type /* random access */, SIMD simd, F& f, G& g, R&& init, size_t workers, C& c, Cs&... cs) {
+    typedef std::decay_t<R> S;
+
+    if(workers < 2) {
+        return detail::map_fold(simd, f, g, std::forward<R>(init), c, cs...);
+    }
+
+    std::vector<std::unique_ptr<S>> parts(workers);
+
+    detail::parallel_for(workers, detail::size(c, detail::has_size<C>()), [&](size_t w, size_t lo, size_t hi) {
+        if(lo < hi) {
+            parts[w].reset(new S(detail::map_fold_range<S>(simd, f, g, lo, hi, detail::begin(c), detail::begin(cs)...)));
+        }
+    });
+
+    S mutable_state(std::forward<R>(init));
+
+    for(auto& part : parts) {
+        if(part) {
+            mutable_state = g(std::move(mutable_state), std::move(*part));
+        }
+    }
+
+    return mutable_state;
+}
+
+template <typename SIMD, typename F, typename G, typename R, typename C, typename... Cs>
+std::decay_t<R> parallel_map_fold(std::false_type, SIMD simd, F& f, G& g, R&& init, size_t, C& c, Cs&... cs) {
+    return detail::map_fold(simd, f, g, std::forward<R>(init), c, cs...);
+}
+
+// ----------------------------------------------------------------------------
+// row_iterator
+
+/*
+ * Random access iterator over the rows of a `soa_vector`. Dereferencing 
+ * returns a tuple of references into each column rather than a reference to a 
+ * stored value, similar to `std::vector<bool>`.
+ */
+template <typename SOA, typename REF>
+class row_iterator {
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename std::remove_const_t<SOA>::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef REF reference;
+    typedef void pointer;
+
+    row_iterator() : m_soa(nullptr), m_idx(0) { }
+    row_iterator(SOA* soa, size_t idx) : m_soa(soa), m_idx(idx) { }
+
+    inline REF operator*() const { return (*m_soa)[m_idx]; }
+    inline REF operator[](difference_type n) const { return (*m_soa)[m_idx + n]; }
+
+    inline row_iterator& operator++() { ++m_idx; return *this; }
+    inline row_iterator& operator--() { --m_idx; return *this; }
+    inline row_iterator operator++(int) { row_iterator ret = *this; ++m_idx; return ret; }
+    inline row_iterator operator--(int) { row_iterator ret = *this; --m_idx; return ret; }
+    inline row_iterator& operator+=(difference_type n) { m_idx += n; return *this; }
+    inline row_iterator& operator-=(difference_type n) { m_idx -= n; return *this; }
+    inline row_iterator operator+(difference_type n) const { return row_iterator(m_soa, m_idx + n); }
+    inline row_iterator operator-(difference_type n) const { return row_iterator(m_soa, m_idx - n); }
+    inline difference_type operator-(const row_iterator& rhs) const { return difference_type(m_idx) - difference_type(rhs.m_idx); }
+
+    inline bool operator==(const row_iterator& rhs) const { return m_idx == rhs.m_idx; }
+    inline bool operator!=(const row_iterator& rhs) const { return m_idx != rhs.m_idx; }
+    inline bool operator<(const row_iterator& rhs) const { return m_idx < rhs.m_idx; }
+    inline bool operator>(const row_iterator& rhs) const { return m_idx > rhs.m_idx; }
+    inline bool operator<=(const row_iterator& rhs) const { return m_idx <= rhs.m_idx; }
+    inline bool operator>=(const row_iterator& rhs) const { return m_idx >= rhs.m_idx; }
+
+private:
+    SOA* m_soa;
+    size_t m_idx;
+};
+
+// evaluate an expression for each element of a parameter pack in order
+typedef std::initializer_list<int> expand;
+
+// ----------------------------------------------------------------------------
+// transpose
+
+// a tuple of references to every column of a `soa_vector`
+template <typename SOA, size_t... Is>
+auto columns_of(SOA& soa, std::index_sequence<Is...>) {
+    return std::tie(soa.template column<Is>()...);
+}
+
+// the type of member `T` and the struct `S` a member pointer `T S::*` points into 
+template <typename M>
+struct member_pointer_struct;
+
+template <typename T, typename S>
+struct member_pointer_struct<T S::*> {
+    typedef T type;
+    typedef S owner;
+};
+
+template <typename M>
+using member_t = typename member_pointer_struct<M>::type;
+
+template <typename M>
+using member_owner_t = typename member_pointer_struct<M>::owner;
+
+/*
+ * Rows are transposed a block at a time. The block is sized so its rows stay 
+ * in the L1 cache while each member is copied out of (or into) them, so every 
+ * row is read from memory once no matter how many members are copied.
+ */
+template <typename S>
+constexpr size_t transpose_block() {
+    return sizeof(S) >= 16384 ? 1 : 16384 / sizeof(S);
+}
+
+template <typename IT, typename... Ts, typename... Ms, size_t... Is>
+void to_columns(IT rows, size_t len, std::tuple<std::vector<Ts>&...> cols, std::tuple<Ms...> ms, std::index_sequence<Is...>) {
+    typedef std::decay_t<decltype(*rows)> S;
+    const size_t block = detail::transpose_block<S>();
+
+    for(size_t b = 0; b < len; b += block) {
+        const size_t b_end = std::min(len, b + block);
+
+        (void)detail::expand{ (
+            [&](auto* col, auto m) {
+                for(size_t i = b; i < b_end; ++i) {
+                    col[i] = rows[i].*m;
+                }
+            }(std::get<Is>(cols).data(), std::get<Is>(ms)), 0)... };
+    }
+}
+
+template <typename S, typename... Ts, typename... Ms, size_t... Is>
+void to_rows(S* rows, size_t len, std::tuple<const std::vector<Ts>&...> cols, std::tuple<Ms...> ms, std::index_sequence<Is...>) {
+    const size_t block = detail::transpose_block<S>();
+
+    for(size_t b = 0; b < len; b += block) {
+        const size_t b_end = std::min(len, b + block);
+
+        (void)detail::expand{ (
+            [&](const auto* col, auto m) {
+                for(size_t i = b; i < b_end; ++i) {
+                    rows[i].*m = col[i];
+                }
+            }(std::get<Is>(cols).data(), std::get<Is>(ms)), 0)... };
+    }
+}
+
+// ----------------------------------------------------------------------------
+// aggregate
+
+// the vector operation of an accumulator which does no work per element (ie, `agg::count`)
+struct keep_op { 
+    template <typename V> 
+    SCA_ALWAYS_INLINE V operator()(const V& a, const V&) const { return a; } 
+    template <typename V> 
+    SCA_ALWAYS_INLINE void operator()(V& r, const V& a, const V&) const { r = a; } 
+};
+
+template <typename T>
+T identity(keep_op) {
+    return T();
+}
+
+// built-in accumulators derive from `simd_agg` with the operation a vector kernel can perform for them
+template <typename OP>
+struct simd_agg { };
+
+template <typename OP>
+std::true_type is_simd_agg(const simd_agg<OP>*);
+std::false_type is_simd_agg(...);
+
+template <typename OP>
+OP simd_agg_op(const simd_agg<OP>*);
+detail::keep_op simd_agg_op(...);
+
+template <typename A>
+using is_simd_agg_t = decltype(detail::is_simd_agg(static_cast<const std::decay_t<A>*>(nullptr)));
+
+template <typename A>
+using simd_agg_op_t = decltype(detail::simd_agg_op(static_cast<const std::decay_t<A>*>(nullptr)));
+
+template <bool... Bs>
+using all_t = std::is_same<std::integer_sequence<bool, true, Bs...>, std::integer_sequence<bool, Bs..., true>>;
+
+// the state of accumulator `A` when aggregating elements of type `T`
+template <typename A, typename T>
+using agg_state_t = std::decay_t<decltype(std::declval<const std::decay_t<A>&>().template init<T>())>;
+
+// the vector operation of a built-in accumulator and the type its lanes are accumulated in
+template <typename OP, typename S>
+struct agg_lane {
+    typedef OP op;
+    typedef S state;
+};
+
+// accumulators which do no work per element keep no lanes of their own state 
+template <typename A, typename T>
+using agg_lane_t = detail::agg_lane<detail::simd_agg_op_t<A>, 
+    std::conditional_t<std::is_same<detail::simd_agg_op_t<A>, detail::keep_op>::value, T, detail::agg_state_t<A, T>>>;
+
+// `std::true_type` if a vector kernel can accumulate lane `L` of elements of 
+// type `T`: in the element type, or summed into wider integers or doubles
+template <typename L, typename T>
+using is_simd_agg_lane_t = std::integral_constant<bool, 
+    std::is_same<typename L::state, T>::value ||
+    (std::is_same<typename L::op, detail::add_op>::value && 
+     ((std::is_integral<T>::value && std::is_same<typename L::state, detail::reduce_value_t<detail::add_op, T>>::value) ||
+      (std::is_same<T, float>::value && std::is_same<typename L::state, double>::value)))>;
+
+/*
+ * `std::true_type` if every accumulator is a built-in and the container can be 
+ * reduced with vector kernels. Only additions change the result of floating 
+ * point accumulators when reordered.
+ */
+template <typename C, typename REASSOCIATE, typename... As>
+using is_simd_aggregate_t = std::integral_constant<bool, 
+    SCA_SIMD &&
+    detail::has_data<C>::value && 
+    detail::is_simd_value<typename std::decay_t<C>::value_type>::value &&
+    detail::all_t<detail::is_simd_agg_t<As>::value...>::value &&
+    detail::all_t<detail::is_simd_agg_lane_t<detail::agg_lane_t<As, typename std::decay_t<C>::value_type>, 
+                                             typename std::decay_t<C>::value_type>::value...>::value &&
+    (REASSOCIATE::value || 
+     std::is_integral<typename std::decay_t<C>::value_type>::value ||
+     detail::all_t<!std::is_same<detail::simd_agg_op_t<As>, detail::add_op>::value...>::value)>;
+
+#if SCA_SIMD
+// add a vector of integers to an accumulator of 64 bit lanes
+template <typename T, size_t BYTES, typename A>
+SCA_ALWAYS_INLINE void widen_add(std::true_type /* integral */, A& acc, const typename vector_of<T, BYTES>::type& v) {
+    detail::widen_lanes<T, BYTES>(acc, v);
+}
+
+// add a vector of floats to an accumulator of doubles, converting a half of the vector at a time
+template <typename T, size_t BYTES, typename A>
+SCA_ALWAYS_INLINE void widen_add(std::false_type, A& acc, const typename vector_of<T, BYTES>::type& v) {
+    typedef typename vector_of<T, BYTES / 2>::type H;
+    H lo;
+    H hi;
+    std::memcpy(&lo, &v, BYTES / 2);
+    std::memcpy(&hi, reinterpret_cast<const char*>(&v) + BYTES / 2, BYTES / 2);
+    acc += __builtin_convertvector(lo, A) + __builtin_convertvector(hi, A);
+}
+
+/*
+ * Every accumulator is updated from the same vector load, so any number of 
+ * them costs a single pass over memory. Accumulators whose state is wider 
+ * than the elements (the sums of narrow integers and means of floats) widen 
+ * every loaded vector into lanes of their state.
+ */
+struct aggregate_kernel {
+    template <size_t BYTES, typename T, typename... Ls>
+    static SCA_ALWAYS_INLINE std::tuple<typename Ls::state...> run(std::tuple<Ls...> lanes, const T* p, size_t len) {
+        return run<BYTES>(lanes, p, len, std::index_sequence_for<Ls...>());
+    }
+
+    // update the accumulator of lane `L` with the vector `v` of `T`s
+    template <size_t BYTES, typename T, typename L, typename A, typename V>
+    static SCA_ALWAYS_INLINE void step(A& acc, const V& v) {
+        step<BYTES, T>(std::integral_constant<bool, (sizeof(typename L::state) > sizeof(T))>(), typename L::op(), acc, v);
+    }
+
+    template <size_t BYTES, typename T, typename OP, typename V>
+    static SCA_ALWAYS_INLINE void step(std::false_type /* widening */, OP op, V& acc, const V& v) {
+        op(acc, acc, v);
+    }
+
+    template <size_t BYTES, typename T, typename A, typename V>
+    static SCA_ALWAYS_INLINE void step(std::true_type /* widening */, add_op, A& acc, const V& v) {
+        detail::widen_add<T, BYTES>(std::is_integral<T>(), acc, v);
+    }
+
+    // fold the lanes of accumulator `acc` into its scalar state `s`
+    template <typename OP, typename S, typename A>
+    static SCA_ALWAYS_INLINE void finish(OP op, S& s, const A& acc) {
+        for(size_t l = 0; l < sizeof(A) / sizeof(S); ++l) {
+            s = op(s, S(acc[l]));
+        }
+    }
+
+    template <size_t BYTES, typename T, typename... Ls, size_t... Is>
+    static SCA_ALWAYS_INLINE std::tuple<typename Ls::state...> run(std::tuple<Ls...>, const T* p, size_t len, std::index_sequence<Is...>) {
+        typedef detail::vector_of<T, BYTES> VO;
+        typedef typename VO::type V;
+        const size_t lanes = VO::lanes;
+        std::tuple<typename detail::vector_of<typename Ls::state, BYTES>::type...> acc0;
+        (void)detail::expand{ (detail::broadcast(std::get<Is>(acc0), detail::identity<typename Ls::state>(typename Ls::op())), 0)... };
+        auto acc1 = acc0;
+        size_t i = 0;
+
+        for(; i + 2 * lanes <= len; i += 2 * lanes) {
+            V v0;
+            V v1;
+            detail::load(v0, p + i);
+            detail::load(v1, p + i + lanes);
+            (void)detail::expand{ (step<BYTES, T, Ls>(std::get<Is>(acc0), v0), 0)... };
+            (void)detail::expand{ (step<BYTES, T, Ls>(std::get<Is>(acc1), v1), 0)... };
+        }
+
+        for(; i + lanes <= len; i += lanes) {
+            V v0;
+            detail::load(v0, p + i);
+            (void)detail::expand{ (step<BYTES, T, Ls>(std::get<Is>(acc0), v0), 0)... };
+        }
+
+        (void)detail::expand{ (typename Ls::op()(std::get<Is>(acc0), std::get<Is>(acc0), std::get<Is>(acc1)), 0)... };
+        std::tuple<typename Ls::state...> ret(detail::identity<typename Ls::state>(typename Ls::op())...);
+        (void)detail::expand{ (finish(typename Ls::op(), std::get<Is>(ret), std::get<Is>(acc0)), 0)... };
+
+        for(; i < len; ++i) {
+            (void)detail::expand{ (std::get<Is>(ret) = typename Ls::op()(std::get<Is>(ret), typename Ls::state(p[i])), 0)... };
+        }
+
+        return ret;
+    }
+};
+
+// vectorized aggregation of a contiguous container by built-in accumulators
+template <typename C, size_t... Is, typename... As>
+auto aggregate(std::true_type, C& c, std::index_sequence<Is...>, const As&... as) {
+    typedef typename std::decay_t<C>::value_type T;
+    const auto r = detail::simd_dispatch<detail::aggregate_kernel>(
+        std::tuple<detail::agg_lane_t<As, T>...>(), c.data(), c.size());
+    return std::make_tuple(as.result(std::get<Is>(r), c.size())...);
+}
+#endif
+
+// single pass aggregation, updating the state of every accumulator with each element in order
+template <typename C, size_t... Is, typename... As>
+auto aggregate(std::false_type, C& c, std::index_sequence<Is...>, const As&... as) {
+    typedef typename std::decay_t<C>::value_type T;
+    auto states = std::make_tuple(as.template init<T>()...);
+    size_t n = 0;
+
+    for(auto&& e : c) {
+        (void)detail::expand{ (as.add(std::get<Is>(states), e), 0)... };
+        ++n;
+    }
+
+    return std::make_tuple(as.result(std::get<Is>(states), n)...);
+}
+
+// ----------------------------------------------------------------------------
+// radix sort 
+
+// `std::true_type` if `T` can be converted to an unsigned radix key of the same order
+template <typename T>
+using is_radix_key_t = std::integral_constant<bool, 
+    detail::is_simd_value<T>::value && 
+    (std::is_integral<T>::value || sizeof(T) == sizeof(uint32_t) || sizeof(T) == sizeof(uint64_t))>;
+
+// the unsigned integer type a radix key of type `T` is sorted as
+template <typename T>
+using radix_key_t = std::conditional_t<
+    std::is_integral<T>::value, 
+    std::make_unsigned_t<std::conditional_t<std::is_integral<T>::value, T, int>>, 
+    std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>>;
+
+// map integers to unsigned integers of the same order by flipping the sign bit
+template <typename T>
+radix_key_t<T> to_radix_key(std::true_type /* integral */, T t) {
+    typedef radix_key_t<T> UK;
+    const UK sign = std::is_signed<T>::value ? UK(UK(1) << (sizeof(UK) * 8 - 1)) : UK(0);
+    return UK(UK(t) ^ sign);
+}
+
+// map IEEE floating point values to unsigned integers of the same order: 
+// negative values have every bit flipped, positive values only the sign bit 
+template <typename T>
+radix_key_t<T> to_radix_key(std::false_type, T t) {
+    typedef radix_key_t<T> UK;
+    const UK sign = UK(1) << (sizeof(UK) * 8 - 1);
+    UK bits;
+    std::memcpy(&bits, &t, sizeof(UK));
+    return (bits & sign) ? UK(~bits) : UK(bits | sign);
+}
+
+template <typename T>
+radix_key_t<T> to_radix_key(T t) {
+    return detail::to_radix_key(std::is_integral<T>(), t);
+}
+
+template <typename T>
+T from_radix_key(std::true_type /* integral */, radix_key_t<T> k) {
+    typedef radix_key_t<T> UK;
+    const UK sign = std::is_signed<T>::value ? UK(UK(1) << (sizeof(UK) * 8 - 1)) : UK(0);
+    return T(UK(k ^ sign));
+}
+
+template <typename T>
+T from_radix_key(std::false_type, radix_key_t<T> k) {
+    typedef radix_key_t<T> UK;
+    const UK sign = UK(1) << (sizeof(UK) * 8 - 1);
+    const UK bits = (k & sign) ? UK(k & ~sign) : UK(~k);
+    T t;
+    std::memcpy(&t, &bits, sizeof(UK));
+    return t;
+}
+
+template <typename T>
+T from_radix_key(radix_key_t<T> k) {
+    return detail::from_radix_key<T>(std::is_integral<T>(), k);
+}
+
+// move every key (and payload) to the next free slot of its byte's bucket 
+template <typename UK, size_t... Is, typename TMP, typename... Ps>
+void radix_scatter(const std::vector<UK>& keys, std::vector<UK>& keys_tmp, size_t* offsets, size_t shift,
+                   std::index_sequence<Is...>, TMP& payloads_tmp, std::vector<Ps>&... payloads) {
+    for(size_t i = 0; i < keys.size(); ++i) {
+        const size_t pos = offsets[(keys[i] >> shift) & 0xFF]++;
+        keys_tmp[pos] = keys[i];
+        (void)detail::expand{ (std::get<Is>(payloads_tmp)[pos] = std::move(payloads[i]), 0)... };
+    }
+}
+
+template <size_t... Is, typename TMP, typename... Ps>
+void radix_swap(std::index_sequence<Is...>, TMP& payloads_tmp, std::vector<Ps>&... payloads) {
+    (void)detail::expand{ (payloads.swap(std::get<Is>(payloads_tmp)), 0)... };
+}
+
+/*
+ * Stable least significant digit radix sort of unsigned keys, one byte per 
+ * pass. Every payload is permuted along with the keys. The histograms of all 
+ * digits are counted in a single pass, and digits where every key shares the 
+ * same byte are skipped.
+ */
+template <typename UK, typename... Ps>
+void radix_sort(std::vector<UK>& keys, std::vector<Ps>&... payloads) {
+    const size_t len = keys.size();
+    const size_t digits = sizeof(UK);
+    std::vector<size_t> counts(digits * 256, 0);
+
+    for(const UK k : keys) {
+        for(size_t d = 0; d < digits; ++d) {
+            ++counts[d * 256 + ((k >> (d * 8)) & 0xFF)];
+        }
+    }
+
+    std::vector<UK> keys_tmp(len);
+    auto payloads_tmp = std::make_tuple(std::vector<Ps>(len)...);
+
+    for(size_t d = 0; d < digits && len; ++d) {
+        size_t* offsets = &counts[d * 256];
+        const size_t shift = d * 8;
+
+        if(offsets[(keys[0] >> shift) & 0xFF] == len) {
+            continue; 
+        }
+
+        size_t total = 0;
+
+        for(size_t b = 0; b < 256; ++b) {
+            const size_t count = offsets[b];
+            offsets[b] = total;
+            total += count;
+        }
+
+        detail::radix_scatter(keys, keys_tmp, offsets, shift, 
+                              std::index_sequence_for<Ps...>(), payloads_tmp, payloads...);
+        keys.swap(keys_tmp);
+        detail::radix_swap(std::index_sequence_for<Ps...>(), payloads_tmp, payloads...);
+    }
+}
+
+/*
+ * `std::true_type` if `sca::sort()` of elements `T` with comparison `F` can 
+ * use a radix sort. Only the standard orderings of arithmetic types are 
+ * recognized, other comparisons may not agree with the order of the keys.
+ */
+template <typename F, typename T>
+struct radix_order_struct {
+    static const bool ascending = false;
+    static const bool descending = false;
+};
+
+template <typename U, typename T>
+struct radix_order_struct<std::less<U>, T> {
+    static const bool ascending = std::is_void<U>::value || std::is_same<U, T>::value;
+    static const bool descending = false;
+};
+
+template <typename U, typename T>
+struct radix_order_struct<std::greater<U>, T> {
+    static const bool ascending = false;
+    static const bool descending = std::is_void<U>::value || std::is_same<U, T>::value;
+};
+
+template <typename F, typename T>
+using is_radix_sort_t = std::integral_constant<bool, 
+    detail::is_radix_key_t<T>::value && 
+    (detail::radix_order_struct<std::decay_t<F>, T>::ascending || 
+     detail::radix_order_struct<std::decay_t<F>, T>::descending)>;
+
+// below this many elements a comparison sort is faster than a radix sort
+constexpr size_t radix_sort_threshold = 512;
+
+// sort arithmetic values in ascending order by converting them to radix keys and back
+template <typename T>
+void radix_sort_values(std::vector<T>& values) {
+    std::vector<radix_key_t<T>> keys(values.size());
+
+    for(size_t i = 0; i < values.size(); ++i) {
+        keys[i] = detail::to_radix_key(values[i]);
+    }
+
+    detail::radix_sort(keys);
+
+    for(size_t i = 0; i < values.size(); ++i) {
+        values[i] = detail::from_radix_key<T>(keys[i]);
+    }
+}
+
+template <typename R, typename F>
+void sort(std::true_type /* radix */, R& ret, F& cmp) {
+    typedef typename R::value_type T;
+
+    if(ret.size() < detail::radix_sort_threshold) {
+        std::sort(ret.begin(), ret.end(), cmp);
+    } else {
+        detail::radix_sort_values(ret);
+
+        if(detail::radix_order_struct<std::decay_t<F>, T>::descending) {
+            std::reverse(ret.begin(), ret.end());
+        }
+    }
+}
+
+// move the elements of `c` into a new container in the order of `idxs`
+template <typename C>
+detail::to_vector_t<C> permute(C&& c, const std::vector<size_t>& idxs) {
+    const size_t len = idxs.size();
+    detail::to_vector_t<C> src(len);
+    detail::range_transfer(detail::is_lvalue_ref_t<C>(), src.begin(), c.begin(), c.end());
+    detail::to_vector_t<C> ret;
+    ret.reserve(len);
+
+    for(size_t i = 0; i < len; ++i) {
+        ret.push_back(std::move(src[idxs[i]]));
+    }
+
+    return ret;
+}
+
+// ----------------------------------------------------------------------------
+// string sort 
+
+// groups of strings up to this size are sorted by comparing whole strings
+constexpr size_t string_sort_small = 32;
+
+// the 8 bytes of `s` starting at `depth` as a big endian integer, zero padded
+// past the end of the string, so integers order the same as the bytes 
+inline uint64_t string_key(const std::string& s, size_t depth) {
+    unsigned char bytes[8] = { 0 };
+
+    if(depth < s.size()) {
+        std::memcpy(bytes, s.data() + depth, std::min(sizeof(bytes), s.size() - depth));
+    }
+
+    uint64_t key = 0;
+
+    for(const unsigned char b : bytes) {
+        key = (key << 8) | b;
+    }
+
+    return key;
+}
+
+/*
+ * Most significant digit radix sort of strings using 8 byte digits. The 
+ * digits of the strings in `idxs[lo, hi)`, which share their first `depth` 
+ * bytes, are cached in an integer array which is radix sorted along with the 
+ * indices, so the sort reads each string's bytes once per level instead of 
+ * once per comparison. Groups of equal digits are sorted recursively on the 
+ * next 8 bytes, and small groups by comparing whole strings.
+ */
+inline void string_sort(const std::vector<std::string>& strs, std::vector<size_t>& idxs, 
+                        size_t lo, size_t hi, size_t depth) {
+    const size_t len = hi - lo;
+
+    if(len < 2) {
+        return;
+    } else if(len <= detail::string_sort_small) {
+        std::sort(idxs.begin() + lo, idxs.begin() + hi, 
+                  [&](size_t a, size_t b) { return strs[a] < strs[b]; });
+        return;
+    }
+
+    std::vector<uint64_t> keys(len);
+    std::vector<size_t> group(idxs.begin() + lo, idxs.begin() + hi);
+
+    bool shared = true;
+
+    for(size_t i = 0; i < len; ++i) {
+        keys[i] = detail::string_key(strs[group[i]], depth);
+        shared = shared && keys[i] == keys[0];
+    }
+
+    if(!shared) {
+        detail::radix_sort(keys, group);
+        std::copy(group.begin(), group.end(), idxs.begin() + lo);
+    }
+
+    for(size_t first = 0; first < len;) {
+        size_t last = first + 1;
+        bool longer = strs[group[first]].size() > depth + 8;
+
+        for(; last < len && keys[last] == keys[first]; ++last) {
+            longer = longer || strs[group[last]].size() > depth + 8;
+        }
+
+        if(longer) {
+            detail::string_sort(strs, idxs, lo + first, lo + last, depth + 8);
+        } else {
+            // every string ends within these 8 bytes, so strings with equal 
+            // digits differ only in trailing '\0's and the shorter is less
+            std::sort(idxs.begin() + lo + first, idxs.begin() + lo + last, 
+                      [&](size_t a, size_t b) { return strs[a].size() < strs[b].size(); });
+        }
+
+        first = last;
+    }
+}
+
+template <typename R>
+void string_sort(R& ret) {
+    std::vector<size_t> idxs(ret.size());
+
+    for(size_t i = 0; i < idxs.size(); ++i) {
+        idxs[i] = i;
+    }
+
+    detail::string_sort(ret, idxs, 0, ret.size(), 0);
+    ret = detail::permute(std::move(ret), idxs);
+}
+
+template <typename F, typename T>
+using is_string_sort_t = std::integral_constant<bool, 
+    std::is_same<T, std::string>::value && 
+    (detail::radix_order_struct<std::decay_t<F>, T>::ascending || 
+     detail::radix_order_struct<std::decay_t<F>, T>::descending)>;
+
+template <typename R, typename F>
+void sort_strings(std::true_type /* string */, R& ret, F& cmp) {
+    typedef typename R::value_type T;
+
+    if(ret.size() <= detail::string_sort_small) {
+        std::sort(ret.begin(), ret.end(), cmp);
+    } else {
+        detail::string_sort(ret);
+
+        if(detail::radix_order_struct<std::decay_t<F>, T>::descending) {
+            std::reverse(ret.begin(), ret.end());
+        }
+    }
+}
+
+template <typename R, typename F>
+void sort_strings(std::false_type, R& ret, F& cmp) {
+    std::sort(ret.begin(), ret.end(), cmp);
+}
+
+template <typename R, typename F>
+void sort(std::false_type, R& ret, F& cmp) {
+    typedef typename R::value_type T;
+    detail::sort_strings(detail::is_string_sort_t<F, T>(), ret, cmp);
+}
+
+// sort arithmetic keys in the standard order with a stable radix sort 
+template <typename K, typename F>
+std::vector<size_t> sort_by(std::true_type /* radix */, std::vector<K>& keys, F& /* cmp */) {
+    typedef std::decay_t<F> CMP;
+    const size_t len = keys.size();
+    std::vector<detail::radix_key_t<K>> rkeys(len);
+    std::vector<size_t> idxs(len);
+
+    for(size_t i = 0; i < len; ++i) {
+        // descending keys are inverted so the sort stays stable
+        rkeys[i] = detail::radix_order_struct<CMP, K>::descending 
+            ? detail::radix_key_t<K>(~detail::to_radix_key(keys[i])) 
+            : detail::to_radix_key(keys[i]);
+        idxs[i] = i;
+    }
+
+    detail::radix_sort(rkeys, idxs);
+    return idxs;
+}
+
+// sort (key, index) pairs, breaking ties on the index so the sort is stable 
+template <typename K, typename F>
+std::vector<size_t> sort_by(std::false_type, std::vector<K>& keys, F& cmp) {
+    const size_t len = keys.size();
+    std::vector<std::pair<K, size_t>> decorated;
+    decorated.reserve(len);
+
+    for(size_t i = 0; i < len; ++i) {
+        decorated.emplace_back(std::move(keys[i]), i);
+    }
+
+    std::sort(decorated.begin(), decorated.end(), 
+        [&](const std::pair<K, size_t>& a, const std::pair<K, size_t>& b) {
+            return cmp(a.first, b.first) || (!cmp(b.first, a.first) && a.second < b.second);
+        });
+
+    std::vector<size_t> idxs(len);
+
+    for(size_t i = 0; i < len; ++i) {
+        idxs[i] = decorated[i].second;
+    }
+
+    return idxs;
+}
+
+// ----------------------------------------------------------------------------
+// network sort 
+
+// containers of arithmetic elements up to this size are sorted with a sorting network
+constexpr size_t network_sort_threshold = 32;
+
+// order two elements without branching on their values
+template <typename T, typename F>
+SCA_ALWAYS_INLINE void compare_swap(std::true_type /* arithmetic */, T& a, T& b, F& cmp) {
+    const T x = a;
+    const T y = b;
+    const bool c = cmp(y, x);
+    a = c ? y : x;
+    b = c ? x : y;
+}
+
+template <typename T, typename F>
+SCA_ALWAYS_INLINE void compare_swap(std::false_type, T& a, T& b, F& cmp) {
+    if(cmp(b, a)) {
+        using std::swap;
+        swap(a, b);
+    }
+}
+
+/*
+ * Batcher's odd-even merge sorting network for `N` elements. The comparator 
+ * pairs are computed at compile time, and `run()` expands to a fixed sequence 
+ * of compare-swaps on constant indices, which the compiler can turn into 
+ * branch-free min/max instructions and vectorize.
+ */
+template <size_t N>
+struct network {
+    // visit the comparators of the network in order 
+    template <typename V>
+    static constexpr size_t visit(V& v) {
+        size_t count = 0;
+
+        for(size_t p = 1; p < N; p <<= 1) {
+            for(size_t k = p; k >= 1; k >>= 1) {
+                for(size_t j = k % p; j + k < N; j += 2 * k) {
+                    for(size_t i = 0; i < k && i < N - j - k; ++i) {
+                        if((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                            v(count, i + j, i + j + k);
+                            ++count;
+                        }
+                    }
+                }
+            }
+        }
+
+        return count;
+    }
+
+    struct counter {
+        constexpr void operator()(size_t, size_t, size_t) { }
+    };
+
+    static constexpr size_t count() {
+        counter c{};
+        return visit(c);
+    }
+
+    static constexpr size_t size = count();
+
+    struct comparators {
+        size_t lo[size ? size : 1];
+        size_t hi[size ? size : 1];
+
+        constexpr void operator()(size_t idx, size_t l, size_t h) {
+            lo[idx] = l;
+            hi[idx] = h;
+        }
+    };
+
+    static constexpr comparators make() {
+        comparators cs{};
+        visit(cs);
+        return cs;
+    }
+
+    static constexpr comparators pairs = make();
+
+    template <typename T, typename F>
+    static SCA_ALWAYS_INLINE void run(T*, F&, std::index_sequence<>) {
+    }
+
+    template <typename T, typename F, size_t... Is>
+    static SCA_ALWAYS_INLINE void run(T* v, F& cmp, std::index_sequence<Is...>) {
+        (void)detail::expand{ 
+            (detail::compare_swap(std::is_arithmetic<T>(), v[pairs.lo[Is]], v[pairs.hi[Is]], cmp), 0)... 
+        };
+    }
+
+    template <typename T, typename F>
+    static SCA_FLATTEN void run(T* v, F& cmp) {
+        run(v, cmp, std::make_index_sequence<size>());
+    }
+};
+
+template <size_t N>
+constexpr size_t network<N>::size;
+
+template <size_t N>
+constexpr typename network<N>::comparators network<N>::pairs;
+
+template <typename T, typename F, size_t... Ns>
+void network_sort(T* v, size_t len, F& cmp, std::index_sequence<Ns...>) {
+    typedef void (*run_fn)(T*, F&);
+    static const run_fn runs[] = { &detail::network<Ns>::template run<T, F>... };
+    runs[len](v, cmp);
+}
+
+// sort up to `network_sort_threshold` elements with the network for their count
+template <typename T, typename F>
+void network_sort(T* v, size_t len, F& cmp) {
+    detail::network_sort(v, len, cmp, std::make_index_sequence<detail::network_sort_threshold + 1>());
+}
+
+// sort small containers of numeric elements with a sorting network, returning 
+// `false` if the container was not sorted. Containers of `bool` are excluded, 
+// a `std::vector<bool>` has no `data()` to sort in place.
+template <typename R, typename F>
+bool sort_small(std::true_type /* simd value */, R& ret, F& cmp) {
+    if(ret.size() <= detail::network_sort_threshold) {
+        detail::network_sort(ret.data(), ret.size(), cmp);
+        return true;
+    } else {
+        return false;
+    }
+}
+
+template <typename R, typename F>
+bool sort_small(std::false_type, R&, F&) {
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// stable sort 
+
+// consecutive wins by one side of a merge before switching to galloping
+constexpr size_t stable_sort_min_gallop = 7;
+
+// runs shorter than this are extended with an insertion sort
+constexpr size_t stable_sort_min_run = 32;
+
+// Compute the minimum run length so `len / min_run` is close to, but not 
+// more than, a power of 2, which keeps the final merges balanced.
+inline size_t stable_sort_min_run_length(size_t len) {
+    size_t r = 0;
+
+    while(len >= stable_sort_min_run) {
+        r |= len & 1;
+        len >>= 1;
+    }
+
+    return len + r;
+}
+
+// Exponential search for the first element in `[first, last)` which is not 
+// less than `key`. Finds positions near `first` in O(log distance).
+template <typename IT, typename T, typename F>
+IT gallop_lower(const T& key, IT first, IT last, F& cmp) {
+    size_t len = last - first;
+    size_t hi = 1;
+
+    while(hi < len && cmp(first[hi - 1], key)) {
+        hi <<= 1;
+    }
+
+    const size_t lo = hi >> 1;
+    return std::lower_bound(first + lo, first + std::min(hi, len), key, cmp);
+}
+
+// Exponential search for the first element in `[first, last)` which is 
+// greater than `key`.
+template <typename IT, typename T, typename F>
+IT gallop_upper(const T& key, IT first, IT last, F& cmp) {
+    size_t len = last - first;
+    size_t hi = 1;
+
+    while(hi < len && !cmp(key, first[hi - 1])) {
+        hi <<= 1;
+    }
+
+    const size_t lo = hi >> 1;
+    return std::upper_bound(first + lo, first + std::min(hi, len), key, cmp);
+}
+
+// Return the end of the run starting at `lo`. Strictly descending runs are 
+// reversed in place, which cannot reorder equal elements.
+template <typename T, typename F>
+size_t stable_sort_run(std::vector<T>& v, size_t lo, F& cmp) {
+    const size_t len = v.size();
+    size_t hi = lo + 1;
+
+    if(hi == len) {
+        return hi;
+    }
+
+    if(cmp(v[hi], v[lo])) {
+        while(hi + 1 < len && cmp(v[hi + 1], v[hi])) {
+            ++hi;
+        }
+
+        ++hi;
+        std::reverse(v.begin() + lo, v.begin() + hi);
+    } else {
+        while(hi + 1 < len && !cmp(v[hi + 1], v[hi])) {
+            ++hi;
+        }
+
+        ++hi;
+    }
+
+    return hi;
+}
+
+// binary insertion sort of `[sorted, hi)` into the sorted elements `[lo, sorted)`
+template <typename T, typename F>
+void stable_sort_insert(std::vector<T>& v, size_t lo, size_t sorted, size_t hi, F& cmp) {
+    for(; sorted < hi; ++sorted) {
+        T pivot = std::move(v[sorted]);
+        auto pos = std::upper_bound(v.begin() + lo, v.begin() + sorted, pivot, cmp);
+        std::move_backward(pos, v.begin() + sorted, v.begin() + sorted + 1);
+        *pos = std::move(pivot);
+    }
+}
+
+/*
+ * Merge the adjacent sorted runs `[lo, mid)` and `[mid, hi)`. Elements of the 
+ * left run which are already in place, and elements of the right run which 
+ * are already in place, are found with galloping searches and skipped. The 
+ * remaining left run is moved to a buffer and merged back one element at a 
+ * time until one side wins `stable_sort_min_gallop` times in a row, after 
+ * which the whole streak of that side is found with a galloping search and 
+ * moved at once.
+ */
+template <typename T, typename F>
+void stable_sort_merge(std::vector<T>& v, std::vector<T>& buf, size_t lo, size_t mid, size_t hi, F& cmp) {
+    auto first = v.begin();
+    lo = detail::gallop_upper(v[mid], first + lo, first + mid, cmp) - first;
+
+    if(lo == mid) {
+        return;
+    }
+
+    hi = detail::gallop_lower(v[mid - 1], first + mid, first + hi, cmp) - first;
+
+    buf.clear();
+    buf.insert(buf.end(), std::make_move_iterator(first + lo), std::make_move_iterator(first + mid));
+
+    auto a_cur = buf.begin();
+    auto a_end = buf.end();
+    auto b_cur = first + mid;
+    auto b_end = first + hi;
+    auto dst = first + lo;
+    size_t a_wins = 0;
+    size_t b_wins = 0;
+
+    while(a_cur != a_end && b_cur != b_end) {
+        if(cmp(*b_cur, *a_cur)) {
+            *dst = std::move(*b_cur);
+            ++dst;
+            ++b_cur;
+            ++b_wins;
+            a_wins = 0;
+
+            if(b_wins >= detail::stable_sort_min_gallop) {
+                auto b_stop = detail::gallop_lower(*a_cur, b_cur, b_end, cmp);
+                dst = std::move(b_cur, b_stop, dst);
+                b_cur = b_stop;
+                b_wins = 0;
+            }
+        } else {
+            *dst = std::move(*a_cur);
+            ++dst;
+            ++a_cur;
+            ++a_wins;
+            b_wins = 0;
+
+            if(a_wins >= detail::stable_sort_min_gallop && b_cur != b_end) {
+                auto a_stop = detail::gallop_upper(*b_cur, a_cur, a_end, cmp);
+                dst = std::move(a_cur, a_stop, dst);
+                a_cur = a_stop;
+                a_wins = 0;
+            }
+        }
+    }
+
+    std::move(a_cur, a_end, dst);
+}
+
+/*
+ * Adaptive stable merge sort in the style of timsort. Natural runs are 
+ * detected (and extended to a minimum length with an insertion sort), pushed 
+ * on a stack, and merged while the stack invariants hold so merges stay 
+ * balanced. Already sorted input costs n - 1 comparisons, and input made of 
+ * k sorted runs costs O(n log k).
+ */
+template <typename T, typename F>
+void stable_sort(std::vector<T>& v, F& cmp) {
+    const size_t len = v.size();
+
+    if(len < 2) {
+        return;
+    }
+
+    const size_t min_run = detail::stable_sort_min_run_length(len);
+    std::vector<std::pair<size_t, size_t>> runs; // (start, length)
+    std::vector<T> buf;
+
+    auto merge_at = [&](size_t i) {
+        detail::stable_sort_merge(v, buf, runs[i].first, runs[i + 1].first, 
+                                  runs[i + 1].first + runs[i + 1].second, cmp);
+        runs[i].second += runs[i + 1].second;
+        runs.erase(runs.begin() + i + 1);
+    };
+
+    for(size_t lo = 0; lo < len;) {
+        size_t hi = detail::stable_sort_run(v, lo, cmp);
+
+        if(hi - lo < min_run) {
+            const size_t forced = std::min(lo + min_run, len);
+            detail::stable_sort_insert(v, lo, hi, forced, cmp);
+            hi = forced;
+        }
+
+        runs.emplace_back(lo, hi - lo);
+        lo = hi;
+
+        while(runs.size() > 1) {
+            size_t n = runs.size() - 2;
+
+            if((n > 0 && runs[n - 1].second <= runs[n].second + runs[n + 1].second) || 
+               (n > 1 && runs[n - 2].second <= runs[n - 1].second + runs[n].second)) {
+                if(runs[n - 1].second < runs[n + 1].second) {
+                    --n;
+                }
+
+                merge_at(n);
+            } else if(runs[n].second <= runs[n + 1].second) {
+                merge_at(n);
+            } else {
+                break;
+            }
+        }
+    }
+
+    while(runs.size() > 1) {
+        size_t n = runs.size() - 2;
+
+        if(n > 0 && runs[n - 1].second < runs[n + 1].second) {
+            --n;
+        }
+
+        merge_at(n);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// merge 
+
+/*
+ * K-way merge of sorted containers with a loser tree. The tree stores at each 
+ * internal node `1 ... k-1` the input which lost the match played there, and 
+ * at node 0 the overall winner, so after the winner's head is output only the 
+ * matches on the path from its leaf to the root are replayed: log2(k) 
+ * comparisons per element.
+ *
+ * The inputs may be different container types, each input's current head is 
+ * reached through a pointer and advanced through a function pointer 
+ * instantiated for that input.
+ */
+template <typename R, typename F, typename... Cs>
+struct merge_tree {
+    typedef typename R::value_type T;
+    typedef const T* (*pop_fn)(merge_tree&);
+    static constexpr size_t k = sizeof...(Cs);
+
+    merge_tree(R& ret, F& cmp, Cs&&... cs) : 
+        ret(ret), 
+        cmp(cmp), 
+        its(std::make_tuple(std::make_pair(cs.begin(), cs.end())...)) 
+    { 
+        init(std::index_sequence_for<Cs...>());
+    }
+
+    // push the current head of input I to the output and return the next head 
+    template <size_t I>
+    static const T* pop(merge_tree& mt) {
+        typedef std::tuple_element_t<I, std::tuple<Cs...>> C;
+        auto& it = std::get<I>(mt.its);
+        auto&& e = *it.first;
+        detail::push(detail::is_lvalue_ref_t<C>(), mt.ret, e);
+        ++it.first;
+        return it.first == it.second ? nullptr : &*it.first;
+    }
+
+    template <size_t... Is>
+    void init(std::index_sequence<Is...>) {
+        (void)detail::expand{ (heads[Is] = head_of(std::get<Is>(its)), 0)... };
+        (void)detail::expand{ (pops[Is] = &merge_tree::template pop<Is>, 0)... };
+        tree[0] = build(1);
+    }
+
+    template <typename P>
+    static const T* head_of(P& it) {
+        return it.first == it.second ? nullptr : &*it.first;
+    }
+
+    // `true` if input a's head is output before input b's head, exhausted 
+    // inputs lose and ties go to the earlier input so the merge is stable
+    bool beats(size_t a, size_t b) {
+        if(!heads[a]) {
+            return false;
+        } else if(!heads[b]) {
+            return true;
+        } else {
+            return cmp(*heads[a], *heads[b]) || (!cmp(*heads[b], *heads[a]) && a < b);
+        }
+    }
+
+    // play the matches of the subtree at `node`, returning its winner
+    size_t build(size_t node) {
+        if(node >= k) {
+            return node - k;
+        }
+
+        const size_t left = build(node * 2);
+        const size_t right = build(node * 2 + 1);
+
+        if(beats(left, right)) {
+            tree[node] = right;
+            return left;
+        } else {
+            tree[node] = left;
+            return right;
+        }
+    }
+
+    void run() {
+        size_t winner = tree[0];
+
+        while(heads[winner]) {
+            heads[winner] = pops[winner](*this);
+
+            for(size_t node = (winner + k) / 2; node; node /= 2) {
+                if(beats(tree[node], winner)) {
+                    std::swap(tree[node], winner);
+                }
+            }
+        }
+    }
+
+    R& ret;
+    F& cmp;
+    std::tuple<std::pair<decltype(std::declval<Cs&>().begin()), decltype(std::declval<Cs&>().end())>...> its;
+    const T* heads[k];
+    pop_fn pops[k];
+    size_t tree[k];
+};
+
+// ----------------------------------------------------------------------------
+// flat hash table 
+
+// spread the bits of a `std::hash` value (often the identity for integers) 
+// over every bit of the result (Fibonacci hashing)
+inline size_t mix_hash(size_t h) {
+    return size_t((uint64_t(h) * 0x9E3779B97F4A7C15ull) >> 32) ^ h;
+}
+
+// index of the lowest set bit of a non-zero mask
+inline size_t lowest_bit(uint32_t m) {
+#if defined(__GNUC__) || defined(__clang__)
+    return size_t(__builtin_ctz(m));
+#else 
+    size_t i = 0;
+
+    for(; !(m & 1); m >>= 1) {
+        ++i;
+    }
+
+    return i;
+#endif
+}
+
+// control byte of a slot which never held an element, ends a probe sequence
+constexpr int8_t ctrl_empty = -128;
+
+// control byte of a slot whose element was erased, probe sequences continue past it 
+constexpr int8_t ctrl_deleted = -2;
+
+// count of control bytes (and slots) in a group, which are scanned at once
+constexpr size_t ctrl_group = 16;
+
+// bit `i` is set if control byte `i` of the group at `ctrl` equals `c`
+SCA_ALWAYS_INLINE uint32_t match_ctrl(const int8_t* ctrl, int8_t c) {
+#if SCA_SIMD
+    typedef detail::vector_of<char, detail::ctrl_group>::type V;
+    V group;
+    V key;
+    detail::load(group, ctrl);
+    detail::broadcast(key, char(c));
+    return detail::byte_lane_bits((V)(group == key));
+#else 
+    uint32_t bits = 0;
+
+    for(size_t i = 0; i < detail::ctrl_group; ++i) {
+        bits |= uint32_t(ctrl[i] == c) << i;
+    }
+
+    return bits;
+#endif
+}
+
+// bit `i` is set if slot `i` of the group at `ctrl` is empty or deleted 
+SCA_ALWAYS_INLINE uint32_t match_free(const int8_t* ctrl) {
+#if SCA_SIMD
+    typedef detail::vector_of<char, detail::ctrl_group>::type V;
+    V group;
+    detail::load(group, ctrl);
+    return detail::byte_lane_bits((V)(group < V()));
+#else 
+    uint32_t bits = 0;
+
+    for(size_t i = 0; i < detail::ctrl_group; ++i) {
+        bits |= uint32_t(ctrl[i] < 0) << i;
+    }
+
+    return bits;
+#endif
+}
+
+// elements of a `flat_set` are their own keys and are never modified in place
+template <typename K>
+struct set_policy {
+    typedef const K& reference;
+
+    static const K& key(const K& k) {
+        return k;
+    }
+};
+
+// elements of a `flat_map` are key/value pairs whose key is never modified in place
+template <typename K, typename V>
+struct map_policy {
+    typedef std::pair<const K, V>& reference;
+
+    static const K& key(const std::pair<const K, V>& kv) {
+        return kv.first;
+    }
+};
+
+/*
+ * Open addressing hash table in the style of SwissTable. Every slot has a 
+ * control byte: empty, deleted, or (for a full slot) the low 7 bits of its 
+ * element's hash. The remaining hash bits select a group of 16 slots, and a 
+ * lookup compares all 16 control bytes of a group against the searched hash 
+ * bits with one vector comparison, only comparing keys of matching slots. A 
+ * group with an empty slot ends the probe sequence, otherwise the next group 
+ * is chosen by triangular (quadratic) probing, which visits every group of a 
+ * power of 2 sized table. 
+ *
+ * Elements are stored directly in one array of slots, there is no allocation 
+ * per element. The table grows when more than 7/8 of its slots are used.
+ */
+template <typename K, typename T, typename P, typename H, typename EQ>
+class flat_table {
+public:
+    typedef K key_type;
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef H hasher;
+    typedef EQ key_equal;
+
+    template <typename TABLE, typename REF>
+    class basic_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef REF reference;
+        typedef std::remove_reference_t<REF>* pointer;
+
+        basic_iterator() : m_table(nullptr), m_idx(0) { }
+
+        basic_iterator(TABLE* table, size_t idx) : m_table(table), m_idx(idx) { 
+            skip();
+        }
+
+        // conversion from `iterator` to `const_iterator`
+        template <typename TABLE2, typename REF2>
+        basic_iterator(const basic_iterator<TABLE2, REF2>& o) : m_table(o.m_table), m_idx(o.m_idx) { }
+
+        inline reference operator*() const {
+            return m_table->m_slots[m_idx];
+        }
+
+        inline pointer operator->() const {
+            return &(m_table->m_slots[m_idx]);
+        }
+
+        inline basic_iterator& operator++() {
+            ++m_idx;
+            skip();
+            return *this;
+        }
+
+        inline basic_iterator operator++(int) {
+            basic_iterator ret = *this;
+            ++(*this);
+            return ret;
+        }
+
+        inline bool operator==(const basic_iterator& o) const {
+            return m_idx == o.m_idx;
+        }
+
+        inline bool operator!=(const basic_iterator& o) const {
+            return m_idx != o.m_idx;
+        }
+
+    private:
+        // advance to the next full slot
+        inline void skip() {
+            while(m_idx < m_table->m_capacity && m_table->m_ctrl[m_idx] < 0) {
+                ++m_idx;
+            }
+        }
+
+        TABLE* m_table;
+        size_t m_idx;
+
+        template <typename, typename> friend class basic_iterator;
+    };
+
+    typedef basic_iterator<flat_table, typename P::reference> iterator;
+    typedef basic_iterator<const flat_table, const T&> const_iterator;
+
+    flat_table() = default;
+
+    /// construct with room for `len` elements 
+    explicit flat_table(size_t len) {
+        reserve(len);
+    }
+
+    flat_table(const flat_table& o) : m_hash(o.m_hash), m_eq(o.m_eq) {
+        reserve(o.size());
+
+        for(const T& t : o) {
+            emplace_key(P::key(t), t);
+        }
+    }
+
+    flat_table(flat_table&& o) {
+        swap(o);
+    }
+
+    ~flat_table() {
+        release();
+    }
+
+    // copy and move assignment 
+    flat_table& operator=(flat_table o) {
+        swap(o);
+        return *this;
+    }
+
+    void swap(flat_table& o) {
+        std::swap(m_ctrl, o.m_ctrl);
+        std::swap(m_slots, o.m_slots);
+        std::swap(m_capacity, o.m_capacity);
+        std::swap(m_size, o.m_size);
+        std::swap(m_growth_left, o.m_growth_left);
+        std::swap(m_hash, o.m_hash);
+        std::swap(m_eq, o.m_eq);
+    }
+
+    /// return the number of elements
+    inline size_t size() const {
+        return m_size;
+    }
+
+    /// return `true` if there are no elements
+    inline bool empty() const {
+        return m_size == 0;
+    }
+
+    /// return the number of slots
+    inline size_t capacity() const {
+        return m_capacity;
+    }
+
+    /// return an iterator to the first element 
+    inline iterator begin() {
+        return iterator(this, 0);
+    }
+
+    /// return an iterator past the last element 
+    inline iterator end() {
+        return iterator(this, m_capacity);
+    }
+
+    /// return a const_iterator to the first element 
+    inline const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    /// return a const_iterator past the last element 
+    inline const_iterator end() const {
+        return const_iterator(this, m_capacity);
+    }
+
+    /// make room for `len` elements without growing
+    void reserve(size_t len) {
+        size_t cap = detail::ctrl_group;
+
+        while(cap - cap / 8 < len) {
+            cap *= 2;
+        }
+
+        if(cap > m_capacity) {
+            rehash(cap);
+        }
+    }
+
+    /// remove all elements, keeping the allocated slots
+    void clear() {
+        destroy();
+
+        for(size_t i = 0; i < m_capacity; ++i) {
+            m_ctrl[i] = detail::ctrl_empty;
+        }
+
+        m_size = 0;
+        m_growth_left = m_capacity - m_capacity / 8;
+    }
+
+    /// return an iterator to the element with key `k`, or `end()`
+    inline iterator find(const K& k) {
+        return iterator(this, find_index(k, detail::mix_hash(m_hash(k))));
+    }
+
+    /// return a const_iterator to the element with key `k`, or `end()`
+    inline const_iterator find(const K& k) const {
+        return const_iterator(this, find_index(k, detail::mix_hash(m_hash(k))));
+    }
+
+    /// return `1` if an element has key `k`, otherwise `0`
+    inline size_t count(const K& k) const {
+        return contains(k) ? 1 : 0;
+    }
+
+    /// return `true` if an element has key `k`
+    inline bool contains(const K& k) const {
+        return find_index(k, detail::mix_hash(m_hash(k))) != m_capacity;
+    }
+
+    /**
+     * @brief construct an element from `as` if no element has key `k`
+     * @param k the key of the element, which must be the key the constructed element will have
+     * @param as arguments to construct the element with
+     * @return a pair of an iterator to the element with key `k` and `true` if it was inserted
+     */
+    template <typename... As>
+    std::pair<iterator, bool> emplace_key(const K& k, As&&... as) {
+        const size_t h = detail::mix_hash(m_hash(k));
+        size_t idx = find_index(k, h);
+
+        if(idx != m_capacity) {
+            return std::make_pair(iterator(this, idx), false);
+        }
+
+        if(!m_growth_left) {
+            // mostly deleted slots are reclaimed in place, otherwise grow
+            rehash(m_size < m_capacity / 2 ? m_capacity : std::max(m_capacity * 2, detail::ctrl_group));
+        }
+
+        idx = free_index(h);
+        ::new(static_cast<void*>(m_slots + idx)) T(std::forward<As>(as)...);
+
+        if(m_ctrl[idx] == detail::ctrl_empty) {
+            --m_growth_left;
+        }
+
+        m_ctrl[idx] = int8_t(h & 0x7F);
+        ++m_size;
+        return std::make_pair(iterator(this, idx), true);
+    }
+
+    /// erase the element with key `k`, returning the count of erased elements
+    size_t erase(const K& k) {
+        const size_t idx = find_index(k, detail::mix_hash(m_hash(k)));
+
+        if(idx == m_capacity) {
+            return 0;
+        }
+
+        m_slots[idx].~T();
+        --m_size;
+
+        // a group with an empty slot never continued a probe sequence, so 
+        // the slot can be emptied instead of leaving a deleted marker 
+        if(detail::match_ctrl(m_ctrl.get() + idx / detail::ctrl_group * detail::ctrl_group, detail::ctrl_empty)) {
+            m_ctrl[idx] = detail::ctrl_empty;
+            ++m_growth_left;
+        } else {
+            m_ctrl[idx] = detail::ctrl_deleted;
+        }
+
+        return 1;
+    }
+
+private:
+    size_t find_index(const K& k, size_t h) const {
+        if(!m_capacity) {
+            return m_capacity;
+        }
+
+        const int8_t h2 = int8_t(h & 0x7F);
+        const size_t group_mask = m_capacity / detail::ctrl_group - 1;
+        size_t group = (h >> 7) & group_mask;
+
+        for(size_t step = 1; ; ++step) {
+            const int8_t* ctrl = m_ctrl.get() + group * detail::ctrl_group;
+
+            for(uint32_t m = detail::match_ctrl(ctrl, h2); m; m &= m - 1) {
+                const size_t idx = group * detail::ctrl_group + detail::lowest_bit(m);
+
+                if(m_eq(P::key(m_slots[idx]), k)) {
+                    return idx;
+                }
+            }
+
+            if(detail::match_ctrl(ctrl, detail::ctrl_empty)) {
+                return m_capacity;
+            }
+
+            group = (group + step) & group_mask;
+        }
+    }
+
+    // return the first empty or deleted slot in the probe sequence of `h`
+    size_t free_index(size_t h) const {
+        const size_t group_mask = m_capacity / detail::ctrl_group - 1;
+        size_t group = (h >> 7) & group_mask;
+
+        for(size_t step = 1; ; ++step) {
+            const uint32_t m = detail::match_free(m_ctrl.get() + group * detail::ctrl_group);
+
+            if(m) {
+                return group * detail::ctrl_group + detail::lowest_bit(m);
+            }
+
+            group = (group + step) & group_mask;
+        }
+    }
+
+    // move every element into a new table of `cap` slots
+    void rehash(size_t cap) {
+        flat_table old;
+        swap(old);
+        m_hash = old.m_hash;
+        m_eq = old.m_eq;
+        m_ctrl.reset(new int8_t[cap]);
+        m_slots = std::allocator<T>().allocate(cap);
+        m_capacity = cap;
+        m_growth_left = cap - cap / 8 - old.m_size;
+        m_size = old.m_size;
+
+        for(size_t i = 0; i < cap; ++i) {
+            m_ctrl[i] = detail::ctrl_empty;
+        }
+
+        for(size_t i = 0; i < old.m_capacity; ++i) {
+            if(old.m_ctrl[i] >= 0) {
+                const size_t idx = free_index(detail::mix_hash(m_hash(P::key(old.m_slots[i]))));
+                ::new(static_cast<void*>(m_slots + idx)) T(std::move(old.m_slots[i]));
+                m_ctrl[idx] = old.m_ctrl[i];
+            }
+        }
+    }
+
+    // destroy every element 
+    void destroy() {
+        for(size_t i = 0; i < m_capacity; ++i) {
+            if(m_ctrl[i] >= 0) {
+                m_slots[i].~T();
+            }
+        }
+    }
+
+    void release() {
+        if(m_slots) {
+            destroy();
+            std::allocator<T>().deallocate(m_slots, m_capacity);
+        }
+    }
+
+    std::unique_ptr<int8_t[]> m_ctrl;
+    T* m_slots = nullptr;
+    size_t m_capacity = 0;
+    size_t m_size = 0;
+    size_t m_growth_left = 0;
+    H m_hash;
+    EQ m_eq;
+};
+
+// ----------------------------------------------------------------------------
+// group_by 
+
+// assign every element's key an id, then move (or copy) every element into 
+// the contiguous range of its id: a counting sort on the ids 
+template <typename K, typename T, typename F, typename C>
+void group_by(std::false_type /* multi pass */, std::vector<K>& keys, std::vector<size_t>& offsets, 
+              std::vector<T>& values, F& key, C&& c) {
+    detail::flat_table<K, std::pair<const K, size_t>, detail::map_policy<K, size_t>, std::hash<K>, std::equal_to<K>> id_of;
+    std::vector<size_t> ids;
+    ids.reserve(detail::size(c, detail::has_size<C>()));
+
+    for(auto&& e : c) {
+        K k = key(e);
+        auto it = id_of.emplace_key(k, std::piecewise_construct, std::forward_as_tuple(k), std::forward_as_tuple(keys.size()));
+
+        if(it.second) {
+            keys.push_back(std::move(k));
+        }
+
+        ids.push_back(it.first->second);
+    }
+
+    offsets.assign(keys.size() + 1, 0);
+
+    for(const size_t id : ids) {
+        ++offsets[id + 1];
+    }
+
+    for(size_t i = 1; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    std::vector<size_t> cursors(offsets.begin(), offsets.end() - 1);
+    values.resize(ids.size());
+    size_t i = 0;
+
+    for(auto&& e : c) {
+        detail::transfer(detail::is_lvalue_ref_t<C>(), values[cursors[ids[i]]++], e);
+        ++i;
+    }
+}
+
+// single pass inputs are read into a container first, as they are traversed twice
+template <typename K, typename T, typename F, typename C>
+void group_by(std::true_type /* single pass */, std::vector<K>& keys, std::vector<size_t>& offsets, 
+              std::vector<T>& values, F& key, C&& c) {
+    std::vector<T> src(c.begin(), c.end());
+    detail::group_by(std::false_type(), keys, offsets, values, key, std::move(src));
+}
+
+// ----------------------------------------------------------------------------
+// distinct 
+
+// hash and compare the elements pointed to instead of the pointers 
+template <typename T>
+struct deref_hash {
+    size_t operator()(const T* p) const {
+        return std::hash<T>()(*p);
+    }
+};
+
+template <typename T>
+struct deref_equal {
+    bool operator()(const T* a, const T* b) const {
+        return *a == *b;
+    }
+};
+
+// the output is reserved up front so the set can point into it, storing 
+// each distinct element once
+template <typename R, typename C>
+void distinct(std::false_type /* multi pass */, R& ret, C&& c) {
+    typedef typename R::value_type T;
+    ret.reserve(detail::size(c, detail::has_size<C>()));
+    detail::flat_table<const T*, const T*, detail::set_policy<const T*>, 
+                       detail::deref_hash<T>, detail::deref_equal<T>> seen;
+
+    for(auto&& e : c) {
+        if(!seen.contains(&e)) {
+            detail::push(detail::is_lvalue_ref_t<C>(), ret, e);
+            const T* p = &ret.back();
+            seen.emplace_key(p, p);
+        }
+    }
+}
+
+template <typename R, typename C>
+void distinct(std::true_type /* single pass */, R& ret, C&& c) {
+    R src(c.begin(), c.end());
+    detail::distinct(std::false_type(), ret, std::move(src));
+}
+
+/*
+ * Every element is assigned a partition of the hash space, and each worker 
+ * tracks the elements of one partition in its own set. Equal elements always 
+ * share a partition, so a worker alone decides which occurrence of them is 
+ * first, without locks, and the kept elements are copied out in order.
+ */
+template <typename R, typename C>
+void parallel_distinct(std::true_type /* contiguous */, R& ret, C&& c, size_t workers) {
+    typedef typename R::value_type T;
+    const T* p = c.data();
+    const size_t len = c.size();
+    // partitions are stored in a byte each
+    workers = std::min<size_t>(workers, 256);
+    std::unique_ptr<uint8_t[]> part(new uint8_t[len]);
+    std::unique_ptr<uint8_t[]> keep(new uint8_t[len]());
+
+    detail::parallel_for(workers, len, [&](size_t, size_t lo, size_t hi) {
+        const std::hash<T> hasher;
+
+        for(size_t i = lo; i < hi; ++i) {
+            const uint64_t h = (uint64_t(detail::mix_hash(hasher(p[i]))) * 0x9E3779B97F4A7C15ull) >> 32;
+            part[i] = uint8_t((h * workers) >> 32);
+        }
+    });
+
+    detail::parallel_for(workers, len, [&](size_t w, size_t, size_t) {
+        detail::flat_table<const T*, const T*, detail::set_policy<const T*>, 
+                           detail::deref_hash<T>, detail::deref_equal<T>> seen;
+
+        for(size_t i = 0; i < len; ++i) {
+            if(part[i] == w && seen.emplace_key(p + i, p + i).second) {
+                keep[i] = 1;
+            }
+        }
+    });
+
+    for(size_t i = 0; i < len; ++i) {
+        if(keep[i]) {
+            detail::push(detail::is_lvalue_ref_t<C>(), ret, p[i]);
+        }
+    }
+}
+
+template <typename R, typename C>
+void parallel_distinct(std::false_type, R& ret, C&& c, size_t) {
+    detail::distinct(detail::is_single_pass_t<C>(), ret, std::forward<C>(c));
+}
+
+// ----------------------------------------------------------------------------
+// unique 
+
+template <typename R, typename F, typename C>
+void unique(R& ret, F& eq, C&& c) {
+    for(auto&& e : c) {
+        if(ret.empty() || !eq(ret.back(), e)) {
+            detail::push(detail::is_lvalue_ref_t<C>(), ret, e);
+        }
+    }
+}
+
+/*
+ * Each worker marks and counts the first elements of runs in its range, then 
+ * copies them to its offset in the output. Every comparison is made before 
+ * any element is moved from, so neighbouring workers never race on the 
+ * elements at the edges of their ranges.
+ */
+template <typename R, typename F, typename C>
+void parallel_unique(std::true_type /* contiguous, default constructible */, R& ret, F& eq, C&& c, size_t workers) {
+    auto p = c.data();
+    const size_t len = c.size();
+    std::unique_ptr<uint8_t[]> first(new uint8_t[len]);
+    std::vector<size_t> offsets(workers + 1, 0);
+
+    detail::parallel_for(workers, len, [&](size_t w, size_t lo, size_t hi) {
+        size_t count = 0;
+
+        for(size_t i = lo; i < hi; ++i) {
+            first[i] = i == 0 || !eq(p[i - 1], p[i]);
+            count += first[i];
+        }
+
+        offsets[w + 1] = count;
+    });
+
+    for(size_t w = 0; w < workers; ++w) {
+        offsets[w + 1] += offsets[w];
+    }
+
+    ret.resize(offsets[workers]);
+
+    detail::parallel_for(workers, len, [&](size_t w, size_t lo, size_t hi) {
+        size_t cur = offsets[w];
+
+        for(size_t i = lo; i < hi; ++i) {
+            if(first[i]) {
+                detail::assign(detail::is_lvalue_ref_t<C>(), ret[cur++], p[i]);
+            }
+        }
+    });
+}
+
+template <typename R, typename F, typename C>
+void parallel_unique(std::false_type, R& ret, F& eq, C&& c, size_t) {
+    detail::unique(ret, eq, std::forward<C>(c));
+}
+
+// ----------------------------------------------------------------------------
+// count_by 
+
+// at most this many counters, or one per element, are allocated for dense counting
+constexpr size_t count_by_dense_size = 1 << 16;
+
+// count keys in a hash table 
+template <typename M, typename F, typename C>
+void count_by(std::false_type, M& counts, F& key, C& c) {
+    for(auto&& e : c) {
+        ++counts[key(e)];
+    }
+}
+
+/*
+ * Integer keys are computed into an array first. When they span a small 
+ * range, they are counted by indexing an array of counters, and only the 
+ * non-zero counters are inserted into the table. 
+ */
+template <typename M, typename F, typename C>
+void count_by(std::true_type /* integral */, M& counts, F& key, C& c) {
+    typedef typename M::key_type K;
+    std::vector<K> keys;
+
+    for(auto&& e : c) {
+        keys.push_back(key(e));
+    }
+
+    if(keys.empty()) {
+        return;
+    }
+
+    const auto mm = std::minmax_element(keys.begin(), keys.end());
+    const uint64_t lo = uint64_t(*mm.first);
+    const uint64_t span = uint64_t(*mm.second) - lo;
+
+    if(span < std::max(detail::count_by_dense_size, keys.size())) {
+        std::vector<size_t> dense(span + 1, 0);
+
+        for(const K k : keys) {
+            ++dense[uint64_t(k) - lo];
+        }
+
+        for(size_t i = 0; i < dense.size(); ++i) {
+            if(dense[i]) {
+                counts.try_emplace(K(lo + i), dense[i]);
+            }
+        }
+    } else {
+        for(const K k : keys) {
+            ++counts[k];
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// hash join 
+
+// below this many build side elements a hash join's table fits in cache 
+constexpr size_t hash_join_partition_size = 4096;
+
+/*
+ * A hash table of the build side elements of a join. Each key maps to the 
+ * range of its elements' iterators, which are stored contiguously (counting 
+ * sorted by key), so probing a key visits one slot and one contiguous range.
+ */
+template <typename K, typename E>
+struct join_table {
+    typedef std::pair<size_t, size_t> span;
+    typedef detail::flat_table<K, std::pair<const K, span>, detail::map_policy<K, span>, 
+                               std::hash<K>, std::equal_to<K>> span_table;
+
+    // index `len` element iterators by their keys 
+    join_table(const K* keys, const E* elements, size_t len) : spans(len) {
+        std::vector<size_t> ids(len);
+
+        for(size_t i = 0; i < len; ++i) {
+            // the span of a key holds its id until every key is counted 
+            ids[i] = spans.emplace_key(keys[i], std::piecewise_construct, 
+                std::forward_as_tuple(keys[i]), std::forward_as_tuple(spans.size(), 0)).first->second.first;
+        }
+
+        std::vector<size_t> offsets(spans.size() + 1, 0);
+
+        for(const size_t id : ids) {
+            ++offsets[id + 1];
+        }
+
+        for(size_t i = 1; i < offsets.size(); ++i) {
+            offsets[i] += offsets[i - 1];
+        }
+
+        for(auto& kv : spans) {
+            const size_t id = kv.second.first;
+            kv.second = span(offsets[id], offsets[id + 1]);
+        }
+
+        matches.resize(len);
+
+        for(size_t i = 0; i < len; ++i) {
+            matches[offsets[ids[i]]++] = elements[i];
+        }
+    }
+
+    // call `f` with the iterator of every element whose key equals `k`
+    template <typename F>
+    void probe(const K& k, F&& f) const {
+        auto it = spans.find(k);
+
+        if(it != spans.end()) {
+            for(size_t i = it->second.first; i < it->second.second; ++i) {
+                f(matches[i]);
+            }
+        }
+    }
+
+    span_table spans;
+    std::vector<E> matches;
+};
+
+// iterators to every element of a container with their keys, elements are 
+// not necessarily lvalues (ie, the proxies of a `std::vector<bool>`) so their 
+// addresses cannot be kept
+template <typename K, typename F, typename C>
+auto join_rows(std::vector<K>& keys, F& key, C& c) {
+    std::vector<decltype(c.begin())> elements;
+    const size_t len = detail::size(c, detail::has_size<C>());
+    elements.reserve(len);
+    keys.reserve(len);
+
+    for(auto it = c.begin(), it_end = c.end(); it != it_end; ++it) {
+        elements.push_back(it);
+        keys.push_back(key(*it));
+    }
+
+    return elements;
+}
+
+/*
+ * Join by building a table on the build side and streaming the probe side 
+ * through it. `emit` receives a build element and a probe element and 
+ * pushes their result in the caller's argument order.
+ */
+template <typename KB, typename CB, typename KP, typename CP, typename E>
+void hash_join(KB& build_key, CB& build, KP& probe_key, CP& probe, E&& emit) {
+    typedef std::decay_t<detail::callable_return_t<KB, detail::container_reference_value_t<CB>>> K;
+    std::vector<K> keys;
+    auto elements = detail::join_rows(keys, build_key, build);
+    const detail::join_table<K, typename decltype(elements)::value_type> table(keys.data(), elements.data(), keys.size());
+
+    for(auto&& p : probe) {
+        const K k = probe_key(p);
+        table.probe(k, [&](const auto& b) { emit(*b, p); });
+    }
+}
+
+// reorder keys and element iterators so each partition (the high bits of the 
+// keys' hashes) is contiguous, writing the offset of each partition 
+template <typename K, typename E>
+void partition_rows(std::vector<K>& keys, std::vector<E>& elements, size_t shift, size_t parts, 
+                    std::vector<size_t>& offsets) {
+    std::vector<size_t> part_of(keys.size());
+    std::hash<K> hasher;
+    offsets.assign(parts + 1, 0);
+
+    for(size_t i = 0; i < keys.size(); ++i) {
+        part_of[i] = (uint64_t(detail::mix_hash(hasher(keys[i]))) * 0x9E3779B97F4A7C15ull) >> shift;
+        ++offsets[part_of[i] + 1];
+    }
+
+    for(size_t i = 1; i <= parts; ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    std::vector<size_t> cursors(offsets.begin(), offsets.end() - 1);
+    std::vector<K> part_keys(keys.size());
+    std::vector<E> part_elements(keys.size());
+
+    for(size_t i = 0; i < keys.size(); ++i) {
+        const size_t pos = cursors[part_of[i]]++;
+        part_keys[pos] = std::move(keys[i]);
+        part_elements[pos] = elements[i];
+    }
+
+    keys.swap(part_keys);
+    elements.swap(part_elements);
+}
+
+/*
+ * Radix partitioned join: both sides are partitioned on the same hash bits 
+ * into partitions small enough that each partition's table stays in cache, 
+ * then every build partition is joined with its probe partition. 
+ */
+template <typename KB, typename CB, typename KP, typename CP, typename E>
+void partitioned_hash_join(KB& build_key, CB& build, KP& probe_key, CP& probe, E&& emit) {
+    typedef std::decay_t<detail::callable_return_t<KB, detail::container_reference_value_t<CB>>> K;
+    std::vector<K> build_keys;
+    std::vector<K> probe_keys;
+    auto build_elements = detail::join_rows(build_keys, build_key, build);
+    auto probe_elements = detail::join_rows(probe_keys, probe_key, probe);
+    size_t bits = 0;
+
+    while((build_keys.size() >> bits) > detail::hash_join_partition_size) {
+        ++bits;
+    }
+
+    const size_t parts = size_t(1) << bits;
+    std::vector<size_t> build_offsets(2, 0);
+    std::vector<size_t> probe_offsets(2, 0);
+    build_offsets[1] = build_keys.size();
+    probe_offsets[1] = probe_keys.size();
+
+    if(bits) {
+        detail::partition_rows(build_keys, build_elements, 64 - bits, parts, build_offsets);
+        detail::partition_rows(probe_keys, probe_elements, 64 - bits, parts, probe_offsets);
+    }
+
+    for(size_t part = 0; part < parts; ++part) {
+        const size_t first = build_offsets[part];
+        const detail::join_table<K, typename decltype(build_elements)::value_type> table(
+            build_keys.data() + first, build_elements.data() + first, build_offsets[part + 1] - first);
+
+        for(size_t i = probe_offsets[part]; i < probe_offsets[part + 1]; ++i) {
+            const auto& p = probe_elements[i];
+            table.probe(probe_keys[i], [&](const auto& b) { emit(*b, *p); });
+        }
+    }
+}
+
+}
+
+//------------------------------------------------------------------------------
 // size
 
 /**
- * @brief return an iterable container's size, regardless if it implements a `::size()` method
- * @param c a container 
- * @return the size of the container
+ * @brief return an iterable container's size, regardless if it implements a `::size()` method
+ * @param c a container 
+ * @return the size of the container
+ */
+template <typename C>
+size_t // size_t is convertable from all std:: container `size_type`s
+size(C&& c) { 
+    return detail::size(c, detail::has_size<C>()); 
+}
+
+//------------------------------------------------------------------------------
+// pointers
+
+/**
+ * @brief copy the addresses of elements in a container to a new container
+ *
+ * This a helper mechanism for ensuring all calculations on data are by 
+ * reference to a specific set of values. This can be used to simplify 
+ * operations on large sets of data so that downstream calculations like 
+ * `filter()` and `map()` never have to consider reference value categories.
+ *
+ * This algorithm also useful when sorting data in-place without modifying the 
+ * source data's container positions (std::sort()), while still being able to 
+ * reference the original data within the sorted set. Furthermore, any kind of
+ * sort operation when applied to pointers is very fast.
+ *
+ * It may be beneficial to apply `pointers()` to the result of `slice()`, to 
+ * only operate on the necessary subset of elements.
+ *
+ * @param c container of elements
+ * @return a container of pointers to elements in the argument container
+ */
+template <typename C>
+auto
+pointers(C& c) {
+    typedef typename std::decay_t<C>::value_type CV;
+    std::vector<CV*> ret(sca::size(c));
+    std::transform(c.begin(), c.end(), ret.begin(), [](CV& e){ return &e; });
+    return ret;
+}
+
+template <typename C>
+auto
+pointers(const C& c) {
+    typedef typename std::decay_t<C>::value_type CV;
+    std::vector<const CV*> ret(sca::size(c));
+    std::transform(c.begin(), c.end(), ret.begin(), [](const CV& e){ return &e; });
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// values
+
+/**
+ * @brief return a container of deep value copies (never pointers) from a container of values or pointers 
+ *
+ * If input argument is a container of pointers, those pointers are dereferenced 
+ * before copying.
+ *
+ * Useful when operations on the result of a call to `sca::pointers()` are
+ * complete and a copy of pointed values is required. It is also useful when 
+ * copying an arbitrary container or slice into a vector.
+ *
+ * @param c a container of values or pointers
+ * @return a container of value copies
+ */
+template <typename C>
+auto 
+values(C&& c) {
+    typedef typename std::decay_t<C>::value_type CV;
+    typedef typename std::decay_t<std::remove_pointer_t<CV>> BCV; // base container value type
+    std::vector<BCV> ret(sca::size(c));
+    detail::values(typename std::is_pointer<CV>::type(), ret.begin(), c.begin(), c.end());
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// slice 
+
+/// the underlying type returned by `slice()` representing a subset of a container
+template<typename C>
+class slice_of {
+    typedef std::decay_t<C> DC;
+
+public:
+    typedef typename DC::iterator iterator;
+    typedef typename DC::value_type value_type;
+    typedef typename DC::size_type size_type;
+
+    slice_of() = delete; // no default initialization
+    slice_of(const C& c, size_t idx, size_t len) = delete; // must use const_slice_of
+
+    // mutable lvalue constructor
+    slice_of(C& c, size_t idx, size_t len) :
+        m_size(len),
+        m_begin(std::next(c.begin(), idx)),
+        m_end(std::next(m_begin, len))
+    { }
+
+    // rvalue constructor
+    slice_of(C&& c, size_t idx, size_t len) :
+        m_mem(std::make_shared<DC>(std::move(c))), // keep container in memory
+        m_size(len),
+        m_begin(std::next(m_mem->begin(), idx)),
+        m_end(std::next(m_begin, len))
+    { }
+
+    // iterator constructor
+    template <typename IT>
+    slice_of(IT begin, IT end) : 
+        m_size(std::distance(begin, end)),
+        m_begin(std::move(begin)),
+        m_end(std::move(end))
+    { }
+
+    /// return the iterable length of the slice
+    inline size_t size() const {
+        return m_size;
+    }
+
+    /// return an iterator to the beginning of the container subset
+    inline auto begin() {
+        return m_begin;
+    }
+
+    /// return an iterator to the end of the container subset
+    inline auto end() { 
+        return m_end;
+    }
+
+private:
+    std::shared_ptr<DC> m_mem; // place to hold container memory if constructed with an rvalue 
+    const size_t m_size;
+    iterator m_begin;
+    iterator m_end;
+};
+
+/// const variation of slice_of
+template <typename C>
+class const_slice_of {
+    typedef std::decay_t<C> DC;
+
+public:
+    typedef typename DC::const_iterator const_iterator;
+    typedef typename DC::value_type value_type;
+    typedef typename DC::size_type size_type;
+
+    const_slice_of() = delete; // no default initialization
+
+    // const lvalue constructor
+    const_slice_of(const C& c, size_t idx, size_t len) :
+        m_size(len),
+        m_cbegin(std::next(c.cbegin(), idx)),
+        m_cend(std::next(m_cbegin, len))
+    { }
+
+    // iterator constructor
+    template <typename IT>
+    const_slice_of(IT begin, IT end) : 
+        m_size(std::distance(begin, end)),
+        m_cbegin(std::move(begin)),
+        m_cend(std::move(end))
+    { }
+
+    /// return the iterable length of the slice
+    inline size_t size() const {
+        return m_size;
+    }
+
+    /// return a const_iterator to the beginning of the container subset
+    inline auto begin() const {
+        return m_cbegin;
+    }
+
+    /// return a const_iterator to the end of the container subset
+    inline auto end() const {
+        return m_cend;
+    }
+
+private:
+    const size_t m_size;
+    const_iterator m_cbegin;
+    const_iterator m_cend;
+};
+
+//------------------------------------------------------------------------------
+// range 
+
+/**
+ * @brief the underlying type returned by `range()` representing an arbitrary pair of iterators
+ *
+ * Unlike `slice_of`, a `range_of` never measures itself, making it suitable 
+ * for single pass input iterators (`std::istream_iterator`, generators, socket 
+ * readers, etc.) which can only be traversed once. Algorithms which accept a 
+ * single pass `range_of` never precompute its size, so streams larger than 
+ * memory can be processed by `fold()` and `each()` with bounded memory.
+ */
+template <typename IT>
+class range_of {
+public:
+    typedef IT iterator;
+    typedef typename std::iterator_traits<IT>::value_type value_type;
+
+    range_of() = delete; // no default initialization
+
+    range_of(IT begin, IT end) :
+        m_begin(std::move(begin)),
+        m_end(std::move(end))
+    { }
+
+    /// return an iterator to the beginning of the range
+    inline IT begin() const {
+        return m_begin;
+    }
+
+    /// return an iterator to the end of the range
+    inline IT end() const {
+        return m_end;
+    }
+
+private:
+    IT m_begin;
+    IT m_end;
+};
+
+/**
+ * @brief create a `range_of` object which allows algorithms to iterate a pair of iterators
+ *
+ * Typical usecase is to process a stream without first copying it into a 
+ * container:
+ * ```
+ * std::istream_iterator<int> begin(my_stream), end;
+ * auto my_sum = sca::fold(std::plus<int>(), 0, sca::range(begin, end));
+ * ```
+ *
+ * @param begin iterator to the first element 
+ * @param end iterator past the last element
+ * @return a range object capable of iterating the given iterators
+ */
+template <typename IT>
+range_of<IT>
+range(IT begin, IT end) {
+    return range_of<IT>(std::move(begin), std::move(end));
+}
+
+/**
+ * @brief create a `slice_of` object from a container which allows iteration over a subset of another container
+ *
+ * This implementation only gets selected when the input container is an rvalue.
+ * The `slice_of` object will keep the original container in memory as long as 
+ * the `slice_of` object exists.
+ *
+ * Typical usecase is to use `auto` as the returned variable's type:
+ * ```
+ * auto my_slice = sca::slice(my_container, 0, 13);
+ * auto my_result = sca::map(my_function, my_slice);
+ * ```
+ *
+ * Or to use the slice inline:
+ * ```
+ * auto my_result = sca::map(my_function, sca::slice(my_container, 0, 13));
+ * ```
+ *
+ * @param idx starting index of the range of values 
+ * @param len length of range represented by slice
+ * @param c container to take slice of
+ * @return a slice object capable of iterating a given container
+ */
+template <typename C>
+auto
+slice(C&& c, size_t idx, size_t len) {
+    return slice_of<C>(std::forward<C>(c), idx, len);
+}
+
+/**
+ * @brief create a `const_slice_of` object from a container which allows iteration over a subset of another container
+ *
+ * This is the const lvalue reference implementation.
+ */
+template <typename C>
+auto
+slice(const C& c, size_t idx, size_t len) {
+    return const_slice_of<C>(c, idx, len);
+}
+
+/**
+ * @brief create a `const_slice_of` object from a container which allows iteration over a subset of another container
+ *
+ * This is the lvalue reference implementation. Must return a `const_slice_of` 
+ * in order to prevent inline uses of the slice() from treating the returned 
+ * object as an rvalue. If a mutable `slice_of` object is required, call 
+ * `mslice()` instead.
+ */
+template <typename C>
+auto
+slice(C& c, size_t idx, size_t len) {
+    return const_slice_of<C>(c, idx, len);
+}
+
+/**
+ * @brief create a mutable `slice_of` object which allows iteration of a subset of another container
+ *
+ * This is the mutable reference implementation of the algorithm, returning a 
+ * `slice_of`. This can be dangerous when used inline carelessly, as it will be 
+ * treated as an rvalue by algorithms causing unexpected swaps. Best usage is to 
+ * explicitly save the result of this method as an lvalue before usage:
+ * ```
+ * auto my_lvalue_slice = sca::mslice(my_container, 0, 13);
+ * auto my_result = sca::map(my_function, my_lvalue_slice));
+ * ```
+ *
+ * @param idx starting index of the range of values 
+ * @param len length of range represented by slice
+ * @param c container to take slice of
+ * @return a slice object capable of iterating a given container
+ */
+template <typename C>
+auto
+mslice(C&& c, size_t idx, size_t len) {
+    return slice_of<C>(std::forward<C>(c), idx, len);
+}
+
+// explicitly catch mutable lvalue reference so compiler doesn't convert to `const C&`
+template <typename C>
+auto
+mslice(C& c, size_t idx, size_t len) {
+    return slice_of<C>(c, idx, len);
+}
+
+//------------------------------------------------------------------------------
+// where
+
+/**
+ * @brief return the indices of elements which return `true` when applied to a predicate
+ *
+ * The index of every element is written to the result and the write position 
+ * only advances when the predicate returns `true`, so there is no branch to 
+ * mispredict per element.
+ *
+ * Filtering one column of a `soa_vector` with `where()` and passing the result 
+ * to `soa_vector::gather()` (or `gather()` on other columns) only touches the 
+ * memory of the columns which are actually needed.
+ *
+ * @param f a predicate function which gets applied to each element of the input container
+ * @param c the input container 
+ * @return a container of the indices of elements for which applying the predicate returned `true`
+ */
+template <typename F, typename C>
+std::vector<size_t>
+where(F&& f, C&& c) {
+    std::vector<size_t> ret(sca::size(c));
+    size_t cur = 0;
+    size_t idx = 0;
+
+    for(auto&& e : c) {
+        ret[cur] = idx;
+        cur += f(e) ? 1 : 0;
+        ++idx;
+    }
+
+    ret.resize(cur);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// gather
+
+/**
+ * @brief return a container of the elements at the given indices of another container
+ * @param c a random access container
+ * @param idxs a container of indices into c, typically returned by `where()`
+ * @return a container of copies of `c[i]` for each index i in idxs
+ */
+template <typename C, typename IDXS>
+auto
+gather(const C& c, const IDXS& idxs) {
+    detail::to_vector_t<C> ret(sca::size(idxs));
+    auto it = detail::begin(c);
+    auto rit = detail::begin(ret);
+    size_t cur = 0;
+
+    for(auto i : idxs) {
+        rit[cur] = it[i];
+        ++cur;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// soa_vector
+
+/**
+ * @brief a container of rows whose members are each stored in their own contiguous column 
+ *
+ * A `std::vector` of wide structs drags every member of every element through 
+ * the cache even when an algorithm only reads one member. A `soa_vector` 
+ * (structure of arrays) instead stores the `I`th member of every row in 
+ * `column<I>()`, a plain `std::vector` which can be passed to any algorithm 
+ * (and uses vector kernels when the algorithm has them):
+ * ```
+ * sca::soa_vector<int, double, std::string> rows;
+ * rows.push_back(std::make_tuple(1, 3.5, std::string("one")));
+ * auto large = rows.gather(sca::where(sca::gt(3.0), rows.column<1>()));
+ * ```
+ *
+ * Iterating a `soa_vector` yields rows as tuples of references into each 
+ * column (`std::tuple<Ts&...>`), so it can also be passed to algorithms as a 
+ * container of rows.
+ */
+template <typename... Ts>
+class soa_vector {
+    typedef std::tuple<std::vector<Ts>...> columns;
+    typedef std::index_sequence_for<Ts...> indices;
+
+public:
+    typedef std::tuple<Ts...> value_type;
+    typedef std::tuple<Ts&...> reference;
+    typedef std::tuple<const Ts&...> const_reference;
+    typedef size_t size_type;
+    typedef detail::row_iterator<soa_vector, reference> iterator;
+    typedef detail::row_iterator<const soa_vector, const_reference> const_iterator;
+
+    soa_vector() = default;
+
+    /// construct with `len` value initialized rows
+    explicit soa_vector(size_t len) {
+        resize(len);
+    }
+
+    /// return the number of rows
+    inline size_t size() const {
+        return std::get<0>(m_columns).size();
+    }
+
+    /// return `true` if there are no rows
+    inline bool empty() const {
+        return size() == 0;
+    }
+
+    /// reserve memory for `len` rows in every column
+    inline void reserve(size_t len) {
+        reserve(len, indices());
+    }
+
+    /// resize every column to `len` rows
+    inline void resize(size_t len) {
+        resize(len, indices());
+    }
+
+    /// remove all rows
+    inline void clear() {
+        resize(0);
+    }
+
+    /// append a row 
+    inline void push_back(value_type row) {
+        push_back(std::move(row), indices());
+    }
+
+    /// append a row, constructing each member from the matching argument
+    template <typename... Us>
+    inline void emplace_back(Us&&... us) {
+        static_assert(sizeof...(Us) == sizeof...(Ts), "emplace_back() requires one argument per column");
+        emplace_back(indices(), std::forward<Us>(us)...);
+    }
+
+    /// return the contiguous column storing the `I`th member of every row
+    template <size_t I>
+    inline auto& column() {
+        return std::get<I>(m_columns);
+    }
+
+    /// return the contiguous column storing the `I`th member of every row
+    template <size_t I>
+    inline const auto& column() const {
+        return std::get<I>(m_columns);
+    }
+
+    /// return a row proxy referencing the members of row `idx`
+    inline reference operator[](size_t idx) {
+        return row(idx, indices());
+    }
+
+    /// return a row proxy referencing the members of row `idx`
+    inline const_reference operator[](size_t idx) const {
+        return row(idx, indices());
+    }
+
+    /// return an iterator to the first row
+    inline iterator begin() {
+        return iterator(this, 0);
+    }
+
+    /// return an iterator past the last row
+    inline iterator end() {
+        return iterator(this, size());
+    }
+
+    /// return a const_iterator to the first row
+    inline const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    /// return a const_iterator past the last row
+    inline const_iterator end() const {
+        return const_iterator(this, size());
+    }
+
+    /**
+     * @brief return a `soa_vector` of the rows at the given indices 
+     *
+     * Each column is gathered separately, so only one column at a time is 
+     * being read.
+     *
+     * @param idxs a container of row indices, typically returned by `sca::where()`
+     * @return a new `soa_vector` containing the selected rows in the order of idxs
+     */
+    template <typename IDXS>
+    soa_vector gather(const IDXS& idxs) const {
+        soa_vector ret;
+        gather(ret, idxs, indices());
+        return ret;
+    }
+
+private:
+    template <size_t... Is>
+    void reserve(size_t len, std::index_sequence<Is...>) {
+        (void)detail::expand{ (std::get<Is>(m_columns).reserve(len), 0)... };
+    }
+
+    template <size_t... Is>
+    void resize(size_t len, std::index_sequence<Is...>) {
+        (void)detail::expand{ (std::get<Is>(m_columns).resize(len), 0)... };
+    }
+
+    template <size_t... Is>
+    void push_back(value_type&& row, std::index_sequence<Is...>) {
+        (void)detail::expand{ (std::get<Is>(m_columns).push_back(std::move(std::get<Is>(row))), 0)... };
+    }
+
+    template <size_t... Is, typename... Us>
+    void emplace_back(std::index_sequence<Is...>, Us&&... us) {
+        (void)detail::expand{ (std::get<Is>(m_columns).emplace_back(std::forward<Us>(us)), 0)... };
+    }
+
+    template <size_t... Is>
+    reference row(size_t idx, std::index_sequence<Is...>) {
+        return reference(std::get<Is>(m_columns)[idx]...);
+    }
+
+    template <size_t... Is>
+    const_reference row(size_t idx, std::index_sequence<Is...>) const {
+        return const_reference(std::get<Is>(m_columns)[idx]...);
+    }
+
+    template <typename IDXS, size_t... Is>
+    void gather(soa_vector& ret, const IDXS& idxs, std::index_sequence<Is...>) const {
+        (void)detail::expand{ (ret.template column<Is>() = sca::gather(std::get<Is>(m_columns), idxs), 0)... };
+    }
+
+    columns m_columns;
+};
+
+//------------------------------------------------------------------------------
+// to_columns 
+
+/**
+ * @brief return a `soa_vector` of selected members of each element of a container of structs
+ *
+ * Members are selected with member pointers, and become the columns of the 
+ * result in argument order:
+ * ```
+ * struct tick { long time; double price; int volume; };
+ * std::vector<tick> ticks = ...;
+ * auto cols = sca::to_columns(ticks, &tick::time, &tick::price);
+ * auto mean_price = sca::sum(sca::reassociate, cols.column<1>()) / cols.size();
+ * ```
+ *
+ * Rows are copied in cache sized blocks, so every row is read from memory 
+ * only once no matter how many members are selected.
+ *
+ * @param c a random access container of structs
+ * @param m a pointer to the first member to copy
+ * @param ms optional pointers to additional members to copy
+ * @return a `soa_vector` whose columns hold the selected members of every element of c
+ */
+template <typename C, typename M, typename... Ms>
+auto
+to_columns(const C& c, M m, Ms... ms) {
+    const size_t len = sca::size(c);
+    soa_vector<detail::member_t<M>, detail::member_t<Ms>...> ret(len);
+    detail::to_columns(
+        detail::begin(c), 
+        len, 
+        detail::columns_of(ret, std::index_sequence_for<M, Ms...>()), 
+        std::make_tuple(m, ms...), 
+        std::index_sequence_for<M, Ms...>());
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// to_rows 
+
+/**
+ * @brief return a container of structs assembled from the columns of a `soa_vector`
+ *
+ * This is the inverse of `to_columns()`. Each column is copied into the member 
+ * pointed to by the member pointer in the same position, any other members 
+ * of the struct are value initialized:
+ * ```
+ * auto ticks = sca::to_rows(cols, &tick::time, &tick::price);
+ * ```
+ *
+ * @param soa a `soa_vector` 
+ * @param m a pointer to the member which receives the first column
+ * @param ms optional pointers to the members which receive the remaining columns
+ * @return a container of structs
+ */
+template <typename... Ts, typename M, typename... Ms>
+auto
+to_rows(const soa_vector<Ts...>& soa, M m, Ms... ms) {
+    static_assert(sizeof...(Ts) == 1 + sizeof...(Ms), "to_rows() requires one member pointer per column");
+    typedef detail::member_owner_t<M> S;
+    std::vector<S> ret(soa.size());
+    detail::to_rows(
+        ret.data(), 
+        ret.size(), 
+        detail::columns_of(soa, std::index_sequence_for<Ts...>()), 
+        std::make_tuple(m, ms...), 
+        std::index_sequence_for<Ts...>());
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// group
+
+/**
+ * @brief assemble a container containing all elements of two or more containers 
+ *
+ * @param c the first container whose elements should be grouped together with the others
+ * @param c2 the second container whose elements should be grouped together with the others
+ * @param cs optional, additional containers whose elements should be grouped together with the others
+ * @return a container containing all elements of the arguments
+ */
+template <typename C, typename C2, typename... Cs>
+auto
+group(C&& c, C2&& c2, Cs&&... cs) {
+    detail::to_vector_t<C> ret(detail::sum(sca::size(c), sca::size(c2), sca::size(cs)...));
+    detail::group(ret.begin(), std::forward<C>(c), std::forward<C2>(c2), std::forward<Cs>(cs)...);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// merge
+
+/**
+ * @brief assemble a sorted container containing all elements of two or more sorted containers 
+ *
+ * Each argument container must already be sorted based on the comparison 
+ * Callable. Unlike `sort(group(c, c2, cs...), cmp)` the existing order is 
+ * used: k inputs are merged with a loser tree in O(n log k). The merge is 
+ * stable, equal elements are output in argument order.
+ *
+ * @param cmp a comparison function the argument containers are sorted by
+ * @param c the first sorted container
+ * @param c2 the second sorted container
+ * @param cs optional, additional sorted containers
+ * @return a sorted container containing all elements of the arguments
+ */
+template <typename F, typename C, typename C2, typename... Cs>
+auto
+merge(F&& cmp, C&& c, C2&& c2, Cs&&... cs) {
+    typedef detail::to_vector_t<C> R;
+    R ret;
+    ret.reserve(detail::sum(sca::size(c), sca::size(c2), sca::size(cs)...));
+    detail::merge_tree<R, F, C, C2, Cs...>(
+        ret, cmp, std::forward<C>(c), std::forward<C2>(c2), std::forward<Cs>(cs)...).run();
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// flat_map
+
+/**
+ * @brief an open addressing hash map whose slots are probed 16 at a time through a control byte array
+ *
+ * A `std::unordered_map` allocates a node per element and chases a pointer 
+ * per probe. A `flat_map` stores its elements directly in one array of 
+ * slots, and finds a key by comparing 7 bits of its hash against the control 
+ * bytes of 16 slots at once with a vector comparison, so most lookups touch 
+ * one group of control bytes and one slot:
+ * ```
+ * sca::flat_map<std::string, int> counts;
+ * for(auto& word : words) {
+ *     ++counts[word];
+ * }
+ * ```
+ *
+ * Elements are `std::pair<const K, V>`s, as in a `std::unordered_map`, so 
+ * keys cannot be modified through an iterator. Iteration order is 
+ * unspecified. Inserting may move elements and invalidates iterators and 
+ * references.
+ */
+template <typename K, typename V, typename H = std::hash<K>, typename EQ = std::equal_to<K>>
+class flat_map : public detail::flat_table<K, std::pair<const K, V>, detail::map_policy<K, V>, H, EQ> {
+    typedef detail::flat_table<K, std::pair<const K, V>, detail::map_policy<K, V>, H, EQ> base;
+
+public:
+    typedef V mapped_type;
+    typedef typename base::iterator iterator;
+    typedef typename base::const_iterator const_iterator;
+
+    using base::base;
+
+    /// construct the value of key `k` from `as` if `k` is not in the map
+    template <typename... As>
+    std::pair<iterator, bool> try_emplace(const K& k, As&&... as) {
+        return this->emplace_key(k, std::piecewise_construct, 
+            std::forward_as_tuple(k), std::forward_as_tuple(std::forward<As>(as)...));
+    }
+
+    /// construct the value of key `k` from `as` if `k` is not in the map
+    template <typename... As>
+    std::pair<iterator, bool> try_emplace(K&& k, As&&... as) {
+        return this->emplace_key(k, std::piecewise_construct, 
+            std::forward_as_tuple(std::move(k)), std::forward_as_tuple(std::forward<As>(as)...));
+    }
+
+    /// insert a key/value pair if its key is not in the map
+    std::pair<iterator, bool> insert(std::pair<K, V> kv) {
+        return this->emplace_key(kv.first, std::move(kv));
+    }
+
+    /// return the value of key `k`, inserting a value initialized value if `k` is not in the map
+    V& operator[](const K& k) {
+        return try_emplace(k).first->second;
+    }
+
+    /// return the value of key `k`, inserting a value initialized value if `k` is not in the map
+    V& operator[](K&& k) {
+        return try_emplace(std::move(k)).first->second;
+    }
+};
+
+//------------------------------------------------------------------------------
+// flat_set
+
+/**
+ * @brief an open addressing hash set whose slots are probed 16 at a time through a control byte array
+ *
+ * The set counterpart of `flat_map`, storing keys directly in an array of 
+ * slots. Iteration order is unspecified. Inserting may move elements and 
+ * invalidates iterators and references.
+ */
+template <typename K, typename H = std::hash<K>, typename EQ = std::equal_to<K>>
+class flat_set : public detail::flat_table<K, K, detail::set_policy<K>, H, EQ> {
+    typedef detail::flat_table<K, K, detail::set_policy<K>, H, EQ> base;
+
+public:
+    typedef typename base::iterator iterator;
+    typedef typename base::const_iterator const_iterator;
+
+    using base::base;
+
+    /// insert a key if it is not in the set
+    std::pair<iterator, bool> insert(const K& k) {
+        return this->emplace_key(k, k);
+    }
+
+    /// insert a key if it is not in the set
+    std::pair<iterator, bool> insert(K&& k) {
+        return this->emplace_key(k, std::move(k));
+    }
+};
+
+//------------------------------------------------------------------------------
+// group_by
+
+/**
+ * @brief the result of `group_by()`: the elements of a container stored contiguously by key
+ *
+ * Instead of one container per key, every element is stored in a single 
+ * `values()` container where the elements of group `i` (whose key is 
+ * `keys()[i]`) occupy the range `[offsets()[i], offsets()[i + 1])`. Groups are 
+ * ordered by when their key was first seen, and the elements of a group keep 
+ * their input order:
+ * ```
+ * auto by_user = sca::group_by([](const event& e) { return e.user; }, events);
+ * for(size_t i = 0; i < by_user.size(); ++i) {
+ *     handle(by_user.key(i), by_user.group(i));
+ * }
+ * ```
+ */
+template <typename K, typename T>
+class groups {
+public:
+    groups() = default;
+
+    groups(std::vector<K> keys, std::vector<size_t> offsets, std::vector<T> values) :
+        m_keys(std::move(keys)),
+        m_offsets(std::move(offsets)),
+        m_values(std::move(values))
+    { }
+
+    /// return the number of groups 
+    inline size_t size() const {
+        return m_keys.size();
+    }
+
+    /// return `true` if there are no groups
+    inline bool empty() const {
+        return m_keys.empty();
+    }
+
+    /// return the key of group `idx`
+    inline const K& key(size_t idx) const {
+        return m_keys[idx];
+    }
+
+    /// return a `const_slice_of` the elements of group `idx`
+    inline auto group(size_t idx) const {
+        return sca::slice(m_values, m_offsets[idx], m_offsets[idx + 1] - m_offsets[idx]);
+    }
+
+    /// return the keys of every group in first seen order
+    inline const std::vector<K>& keys() const {
+        return m_keys;
+    }
+
+    /// return the offsets of every group in `values()`, followed by `values().size()`
+    inline const std::vector<size_t>& offsets() const {
+        return m_offsets;
+    }
+
+    /// return the elements of every group
+    inline const std::vector<T>& values() const {
+        return m_values;
+    }
+
+    /// return the elements of every group, allowing them to be moved out
+    inline std::vector<T>& values() {
+        return m_values;
+    }
+
+private:
+    std::vector<K> m_keys;
+    std::vector<size_t> m_offsets = std::vector<size_t>(1, 0);
+    std::vector<T> m_values;
+};
+
+/**
+ * @brief group the elements of a container by a key computed once per element
+ *
+ * Keys are assigned dense ids with a `flat_map`, then the 
+ * elements are moved (or copied) into a single container ordered by id with a 
+ * counting sort. This allocates a handful of arrays regardless of the count of 
+ * keys, unlike an `std::unordered_map<K, std::vector<T>>`.
+ *
+ * @param key a function which must accept an element from the container and return a hashable key
+ * @param c a container whose elements will be grouped 
+ * @return a `groups` object
+ */
+template <typename F, typename C>
+auto
+group_by(F&& key, C&& c) {
+    typedef std::decay_t<detail::callable_return_t<F, detail::container_reference_value_t<C>>> K;
+    typedef typename std::decay_t<C>::value_type T;
+    std::vector<K> keys;
+    std::vector<size_t> offsets;
+    std::vector<T> values;
+    detail::group_by(detail::is_single_pass_t<C>(), keys, offsets, values, key, std::forward<C>(c));
+    return groups<K, T>(std::move(keys), std::move(offsets), std::move(values));
+}
+
+//------------------------------------------------------------------------------
+// parallel
+
+/**
+ * @brief tag type which requests an algorithm split its work between several threads
+ *
+ * Passing `sca::parallel` as the first argument of an algorithm which 
+ * supports it splits contiguous containers between one `std::thread` per 
+ * hardware thread. Containers with fewer elements than are worth handing to 
+ * a thread are processed on the calling thread. Callables passed alongside 
+ * the tag are called concurrently and must not race on shared state.
+ */
+struct parallel_t { };
+
+/// instance of `parallel_t` to pass to algorithms with a parallel variant
+constexpr parallel_t parallel{};
+
+//------------------------------------------------------------------------------
+// distinct
+
+/**
+ * @brief return a container of the first occurrence of every distinct element of a container
+ *
+ * Unlike sorting and removing duplicates this is O(n) and preserves the order 
+ * elements were first seen in. Elements are tracked in a `flat_set` of 
+ * addresses into the output, so each distinct element is stored once.
+ *
+ * @param c a container whose elements must be hashable and equality comparable
+ * @return a container of distinct elements 
  */
 template <typename C>
-size_t // size_t is convertable from all std:: container `size_type`s
-size(C&& c) { 
-    return detail::size(c, detail::has_size<C>()); 
+auto
+distinct(C&& c) {
+    detail::to_vector_t<C> ret;
+    detail::distinct(detail::is_single_pass_t<C>(), ret, std::forward<C>(c));
+    return ret;
+}
+
+/**
+ * @brief return a container of the first occurrence of every distinct element of a container, using several threads
+ *
+ * Contiguous containers are split by element hash between one worker thread 
+ * per hardware thread (at most 256), so each worker alone tracks every 
+ * occurrence of its elements and no locking is needed. Other containers, and 
+ * containers too small to be worth splitting, are processed as by `distinct()`.
+ *
+ * @param c a container whose elements must be hashable and equality comparable
+ * @return a container of distinct elements 
+ */
+template <typename C>
+auto
+distinct(parallel_t, C&& c) {
+    detail::to_vector_t<C> ret;
+    const size_t workers = detail::parallel_workers(c, detail::has_data<C>());
+
+    if(workers < 2) {
+        detail::distinct(detail::is_single_pass_t<C>(), ret, std::forward<C>(c));
+    } else {
+        detail::parallel_distinct(detail::has_data<C>(), ret, std::forward<C>(c), workers);
+    }
+
+    return ret;
 }
 
 //------------------------------------------------------------------------------
-// pointers
+// unique
 
 /**
- * @brief copy the addresses of elements in a container to a new container
+ * @brief return a container of the elements of a sorted container without consecutive duplicates
  *
- * This a helper mechanism for ensuring all calculations on data are by 
- * reference to a specific set of values. This can be used to simplify 
- * operations on large sets of data so that downstream calculations like 
- * `filter()` and `map()` never have to consider reference value categories.
+ * Every element which equals the element before it is skipped, so a sorted 
+ * container has every duplicate removed in O(n) without hashing.
  *
- * This algorithm also useful when sorting data in-place without modifying the 
- * source data's container positions (std::sort()), while still being able to 
- * reference the original data within the sorted set. Furthermore, any kind of
- * sort operation when applied to pointers is very fast.
+ * @param c a sorted container 
+ * @param eq an equality comparison, defaults to `std::equal_to<>`
+ * @return a container of unique elements 
+ */
+template <typename C, typename F = std::equal_to<>>
+auto
+unique(C&& c, F&& eq = F()) {
+    detail::to_vector_t<C> ret;
+    detail::unique(ret, eq, std::forward<C>(c));
+    return ret;
+}
+
+/**
+ * @brief return a container of the elements of a sorted container without consecutive duplicates, using several threads
  *
- * It may be beneficial to apply `pointers()` to the result of `slice()`, to 
- * only operate on the necessary subset of elements.
+ * Contiguous containers of default constructible elements are split between 
+ * one worker thread per hardware thread, each of which compares and copies 
+ * the elements of its range. Other containers, and containers too small to 
+ * be worth splitting, are processed as by `unique()`.
  *
- * @param c container of elements
- * @return a container of pointers to elements in the argument container
+ * @param c a sorted container 
+ * @param eq an equality comparison, defaults to `std::equal_to<>`, which must be safe to call concurrently
+ * @return a container of unique elements 
+ */
+template <typename C, typename F = std::equal_to<>>
+auto
+unique(parallel_t, C&& c, F&& eq = F()) {
+    typedef detail::to_vector_t<C> R;
+    typedef std::integral_constant<bool, 
+        detail::has_data<C>::value && 
+        std::is_default_constructible<typename R::value_type>::value> CONTIGUOUS;
+    R ret;
+    const size_t workers = detail::parallel_workers(c, CONTIGUOUS());
+
+    if(workers < 2) {
+        detail::unique(ret, eq, std::forward<C>(c));
+    } else {
+        detail::parallel_unique(CONTIGUOUS(), ret, eq, std::forward<C>(c), workers);
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// count_by
+
+/**
+ * @brief return a `flat_map` of the count of elements of a container with each key
+ *
+ * Each key is computed once and counted in place, the table is never copied 
+ * per element as a `fold()` over a map state would. Integer keys spanning a 
+ * small range (ie, enums, bytes, days of the month) are counted by indexing 
+ * an array of counters instead of hashing.
+ *
+ * @param key a function which must accept an element from the container and return a hashable key
+ * @param c a container whose elements will be counted 
+ * @return a `flat_map` from every key to its count of elements
+ */
+template <typename F, typename C>
+auto
+count_by(F&& key, C&& c) {
+    typedef std::decay_t<detail::callable_return_t<F, detail::container_reference_value_t<C>>> K;
+    sca::flat_map<K, size_t> counts;
+    detail::count_by(std::integral_constant<bool, std::is_integral<K>::value>(), counts, key, c);
+    return counts;
+}
+
+//------------------------------------------------------------------------------
+// hash_join
+
+/**
+ * @brief return the results of applying every pair of elements of two containers with equal keys to a Callable
+ *
+ * The equivalent of an SQL inner join. A hash table of the smaller container's 
+ * keys is built (each key is computed once), and every element of the larger 
+ * container is looked up in it, so the cost is O(size(a) + size(b) + matches) 
+ * instead of O(size(a) * size(b)). Results are ordered by the larger 
+ * container's elements, then by the smaller container's matching elements.
+ *
+ * @param key_a a function which must accept an element from `a` and return a hashable key
+ * @param a the first container
+ * @param key_b a function which must accept an element from `b` and return a key comparable to `key_a`'s
+ * @param b the second container
+ * @param f a function which must accept an element from `a` and an element from `b` with equal keys
+ * @return a container of the results of `f`
+ */
+template <typename FA, typename CA, typename FB, typename CB, typename F>
+auto
+hash_join(FA&& key_a, CA&& a, FB&& key_b, CB&& b, F&& f) {
+    typedef std::decay_t<detail::callable_return_t<F, 
+        detail::container_reference_value_t<CA>, 
+        detail::container_reference_value_t<CB>>> R;
+    std::vector<R> ret;
+
+    if(sca::size(a) <= sca::size(b)) {
+        detail::hash_join(key_a, a, key_b, b, [&](auto&& ea, auto&& eb) { ret.push_back(f(ea, eb)); });
+    } else {
+        detail::hash_join(key_b, b, key_a, a, [&](auto&& eb, auto&& ea) { ret.push_back(f(ea, eb)); });
+    }
+
+    return ret;
+}
+
+/**
+ * @brief `hash_join()` which partitions large inputs so each partition's hash table fits in cache
+ *
+ * When the smaller container's hash table is larger than the cache, every 
+ * probe of `hash_join()` is a cache miss. This variant first partitions both 
+ * containers by the high bits of their keys' hashes into partitions of a few 
+ * thousand elements, then joins each pair of partitions with a small table. 
+ * Results are grouped by partition, so their order is unspecified.
+ *
+ * @param key_a a function which must accept an element from `a` and return a hashable key
+ * @param a the first container
+ * @param key_b a function which must accept an element from `b` and return a key comparable to `key_a`'s
+ * @param b the second container
+ * @param f a function which must accept an element from `a` and an element from `b` with equal keys
+ * @return a container of the results of `f`
+ */
+template <typename FA, typename CA, typename FB, typename CB, typename F>
+auto
+partitioned_hash_join(FA&& key_a, CA&& a, FB&& key_b, CB&& b, F&& f) {
+    typedef std::decay_t<detail::callable_return_t<F, 
+        detail::container_reference_value_t<CA>, 
+        detail::container_reference_value_t<CB>>> R;
+    std::vector<R> ret;
+
+    if(sca::size(a) <= sca::size(b)) {
+        detail::partitioned_hash_join(key_a, a, key_b, b, [&](auto&& ea, auto&& eb) { ret.push_back(f(ea, eb)); });
+    } else {
+        detail::partitioned_hash_join(key_b, b, key_a, a, [&](auto&& eb, auto&& ea) { ret.push_back(f(ea, eb)); });
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// reverse
+
+/** 
+ * @brief return a container where the order of elements is the reverse of the input container
+ * @param c an input container 
+ * @return a new container with elements reversed from the input container
  */
 template <typename C>
 auto
-pointers(C& c) {
-    typedef typename std::decay_t<C>::value_type CV;
-    std::vector<CV*> ret(sca::size(c));
-    std::transform(c.begin(), c.end(), ret.begin(), [](CV& e){ return &e; });
+reverse(C&& c) {
+    detail::to_vector_t<C> ret(sca::size(c));
+    detail::range_transfer(detail::is_lvalue_ref_t<C>(), ret.begin(), c.begin(), c.end());
+    std::reverse(ret.begin(), ret.end());
+    return ret; 
+}
+
+//------------------------------------------------------------------------------
+// sort 
+
+/**
+ * @brief return a container whose elements are sorted based on a comparison Callable
+ *
+ * Containers of 32 or less arithmetic (other than `bool`) elements are sorted 
+ * with a sorting network (see `network_sort()`). Large containers of 
+ * arithmetic elements sorted with `std::less<>` or `std::greater<>` are 
+ * sorted with `radix_sort()` instead of a comparison sort, and large 
+ * containers of `std::string` with `string_sort()`.
+ *
+ * @param c container whose elements will be copied and sorted in the output
+ * @param cmp a function which must accept two elements from the container and return a boolean
+ * @return a sorted container of elements 
+ */
+template <typename C, typename F>
+auto
+sort(C&& c, F&& cmp) {
+    typedef typename std::decay_t<C>::value_type T;
+    detail::to_vector_t<C> ret(sca::size(c));
+    detail::range_transfer(detail::is_lvalue_ref_t<C>(), ret.begin(), c.begin(), c.end());
+
+    if(!detail::sort_small(detail::is_simd_value<T>(), ret, cmp)) {
+        detail::sort(detail::is_radix_sort_t<F, T>(), ret, cmp);
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// network_sort
+
+/**
+ * @brief return a std::array whose elements are sorted with a sorting network
+ *
+ * The network is a fixed sequence of compare-and-swap operations chosen at 
+ * compile time for `N` elements, so sorting never branches on the element 
+ * values or allocates. The compiler turns the compare-swaps of arithmetic 
+ * elements into min/max instructions and vectorizes independent ones. The 
+ * sort is not stable.
+ *
+ * @param a array whose elements will be copied and sorted in the output
+ * @param cmp a comparison function, defaults to `std::less<>`
+ * @return a sorted std::array of elements 
+ */
+template <typename T, size_t N, typename F = std::less<>>
+std::array<T, N>
+network_sort(std::array<T, N> a, F&& cmp = F()) {
+    static_assert(N <= detail::network_sort_threshold, "network_sort() is meant for arrays of 32 elements or less");
+    detail::network<N>::run(a.data(), cmp);
+    return a;
+}
+
+//------------------------------------------------------------------------------
+// radix_sort
+
+/**
+ * @brief return a container whose arithmetic elements are sorted in ascending order with a radix sort
+ *
+ * Integers are sorted by their unsigned representation with the sign bit 
+ * flipped, and IEEE floating point values by their bits with negative values 
+ * inverted, one byte per pass in O(n). Bytes which every element shares (ie, 
+ * the high bytes of timestamps) are skipped. `-0.0` is ordered before `0.0`.
+ *
+ * `sort()` selects this algorithm automatically when sorting large containers 
+ * of arithmetic elements with `std::less<>` or `std::greater<>`.
+ *
+ * @param c container whose elements will be copied and sorted in the output
+ * @return a sorted container of elements 
+ */
+template <typename C>
+auto
+radix_sort(C&& c) {
+    typedef typename std::decay_t<C>::value_type T;
+    static_assert(detail::is_radix_key_t<T>::value, "radix_sort() requires arithmetic elements");
+    detail::to_vector_t<C> ret(sca::size(c));
+    detail::range_transfer(detail::is_lvalue_ref_t<C>(), ret.begin(), c.begin(), c.end());
+    detail::radix_sort_values(ret);
     return ret;
 }
 
-template <typename C>
+/**
+ * @brief return a container whose elements are sorted in ascending order of an arithmetic key with a stable radix sort
+ *
+ * The key function is called exactly once per element. Elements with equal 
+ * keys keep their relative order.
+ *
+ * @param c container whose elements will be copied and sorted in the output
+ * @param key a function which must accept an element from the container and return an arithmetic key
+ * @return a sorted container of elements 
+ */
+template <typename C, typename F>
 auto
-pointers(const C& c) {
-    typedef typename std::decay_t<C>::value_type CV;
-    std::vector<const CV*> ret(sca::size(c));
-    std::transform(c.begin(), c.end(), ret.begin(), [](const CV& e){ return &e; });
-    return ret;
+radix_sort(C&& c, F&& key) {
+    typedef std::decay_t<detail::callable_return_t<F, detail::container_reference_value_t<C>>> K;
+    static_assert(detail::is_radix_key_t<K>::value, "radix_sort() requires an arithmetic key");
+    const size_t len = sca::size(c);
+    std::vector<detail::radix_key_t<K>> keys(len);
+    std::vector<size_t> idxs(len);
+    size_t i = 0;
+
+    for(auto&& e : c) {
+        keys[i] = detail::to_radix_key<K>(key(e));
+        idxs[i] = i;
+        ++i;
+    }
+
+    detail::radix_sort(keys, idxs);
+    return detail::permute(std::forward<C>(c), idxs);
 }
 
 //------------------------------------------------------------------------------
-// values
+// stable_sort
 
 /**
- * @brief return a container of deep value copies (never pointers) from a container of values or pointers 
- *
- * If input argument is a container of pointers, those pointers are dereferenced 
- * before copying.
+ * @brief return a container whose elements are stably sorted, exploiting already sorted runs
  *
- * Useful when operations on the result of a call to `sca::pointers()` are
- * complete and a copy of pointed values is required. It is also useful when 
- * copying an arbitrary container or slice into a vector.
+ * Elements which compare equal keep their relative order. The sort is an 
+ * adaptive merge sort in the style of timsort: ascending and strictly 
+ * descending runs already present in the input are detected and merged, so 
+ * sorted or nearly sorted input (ie, the concatenated results of `group()`) 
+ * sorts in close to O(n). Merges gallop through long streaks from one run. 
  *
- * @param c a container of values or pointers
- * @return a container of value copies
+ * @param c container whose elements will be copied and sorted in the output
+ * @param cmp a comparison function, defaults to `std::less<>`
+ * @return a sorted container of elements 
  */
-template <typename C>
-auto 
-values(C&& c) {
-    typedef typename std::decay_t<C>::value_type CV;
-    typedef typename std::decay_t<std::remove_pointer_t<CV>> BCV; // base container value type
-    std::vector<BCV> ret(sca::size(c));
-    detail::values(typename std::is_pointer<CV>::type(), ret.begin(), c.begin(), c.end());
+template <typename C, typename F = std::less<>>
+auto
+stable_sort(C&& c, F&& cmp = F()) {
+    detail::to_vector_t<C> ret(sca::size(c));
+    detail::range_transfer(detail::is_lvalue_ref_t<C>(), ret.begin(), c.begin(), c.end());
+    detail::stable_sort(ret, cmp);
     return ret;
 }
 
 //------------------------------------------------------------------------------
-// slice 
-
-/// the underlying type returned by `slice()` representing a subset of a container
-template<typename C>
-class slice_of {
-    typedef std::decay_t<C> DC;
-
-public:
-    typedef typename DC::iterator iterator;
-    typedef typename DC::value_type value_type;
-    typedef typename DC::size_type size_type;
-
-    slice_of() = delete; // no default initialization
-    slice_of(const C& c, size_t idx, size_t len) = delete; // must use const_slice_of
-
-    // mutable lvalue constructor
-    slice_of(C& c, size_t idx, size_t len) :
-        m_size(len),
-        m_begin(std::next(c.begin(), idx)),
-        m_end(std::next(m_begin, len))
-    { }
-
-    // rvalue constructor
-    slice_of(C&& c, size_t idx, size_t len) :
-        m_mem(std::make_shared<DC>(std::move(c))), // keep container in memory
-        m_size(len),
-        m_begin(std::next(m_mem->begin(), idx)),
-        m_end(std::next(m_begin, len))
-    { }
-
-    // iterator constructor
-    template <typename IT>
-    slice_of(IT begin, IT end) : 
-        m_size(std::distance(begin, end)),
-        m_begin(std::move(begin)),
-        m_end(std::move(end))
-    { }
-
-    /// return the iterable length of the slice
-    inline size_t size() const {
-        return m_size;
-    }
+// top_k
 
-    /// return an iterator to the beginning of the container subset
-    inline auto begin() {
-        return m_begin;
-    }
+/**
+ * @brief return a sorted container of the first k elements a comparison Callable would sort to
+ *
+ * Equivalent to the first `k` elements of `sort(c, cmp)` in O(n log k): a 
+ * bounded heap of the best `k` elements seen so far is maintained, and only 
+ * elements which beat the worst of them are copied (or moved) into it.
+ *
+ * @param c container whose elements will be searched 
+ * @param k the maximum count of elements to return
+ * @param cmp a comparison function, defaults to `std::less<>`
+ * @return a sorted container of at most k elements 
+ */
+template <typename C, typename F = std::less<>>
+auto
+top_k(C&& c, size_t k, F&& cmp = F()) {
+    detail::to_vector_t<C> ret;
+    ret.reserve(std::min(k, sca::size(c)));
 
-    /// return an iterator to the end of the container subset
-    inline auto end() { 
-        return m_end;
+    if(k) {
+        for(auto&& e : c) {
+            if(ret.size() < k) {
+                detail::push(detail::is_lvalue_ref_t<C>(), ret, e);
+                std::push_heap(ret.begin(), ret.end(), cmp);
+            } else if(cmp(e, ret.front())) {
+                std::pop_heap(ret.begin(), ret.end(), cmp);
+                detail::transfer(detail::is_lvalue_ref_t<C>(), ret.back(), e);
+                std::push_heap(ret.begin(), ret.end(), cmp);
+            }
+        }
     }
 
-private:
-    std::shared_ptr<DC> m_mem; // place to hold container memory if constructed with an rvalue 
-    const size_t m_size;
-    iterator m_begin;
-    iterator m_end;
-};
-
-/// const variation of slice_of
-template <typename C>
-class const_slice_of {
-    typedef std::decay_t<C> DC;
-
-public:
-    typedef typename DC::const_iterator const_iterator;
-    typedef typename DC::value_type value_type;
-    typedef typename DC::size_type size_type;
+    std::sort_heap(ret.begin(), ret.end(), cmp);
+    return ret;
+}
 
-    const_slice_of() = delete; // no default initialization
+//------------------------------------------------------------------------------
+// partial_sort
 
-    // const lvalue constructor
-    const_slice_of(const C& c, size_t idx, size_t len) :
-        m_size(len),
-        m_cbegin(std::next(c.cbegin(), idx)),
-        m_cend(std::next(m_cbegin, len))
-    { }
+/**
+ * @brief return a container whose first k elements are sorted based on a comparison Callable
+ *
+ * The first `k` elements are the same as `top_k(c, k, cmp)`, the order of the 
+ * remaining elements is unspecified. Sorting costs O(n log k) instead of 
+ * O(n log n). Prefer `top_k()` when the remaining elements are not needed.
+ *
+ * @param c container whose elements will be copied and partially sorted in the output
+ * @param k the count of elements to sort
+ * @param cmp a comparison function, defaults to `std::less<>`
+ * @return a partially sorted container of elements 
+ */
+template <typename C, typename F = std::less<>>
+auto
+partial_sort(C&& c, size_t k, F&& cmp = F()) {
+    detail::to_vector_t<C> ret(sca::size(c));
+    detail::range_transfer(detail::is_lvalue_ref_t<C>(), ret.begin(), c.begin(), c.end());
+    std::partial_sort(ret.begin(), ret.begin() + std::min(k, ret.size()), ret.end(), cmp);
+    return ret;
+}
 
-    // iterator constructor
-    template <typename IT>
-    const_slice_of(IT begin, IT end) : 
-        m_size(std::distance(begin, end)),
-        m_cbegin(std::move(begin)),
-        m_cend(std::move(end))
-    { }
+//------------------------------------------------------------------------------
+// nth
 
-    /// return the iterable length of the slice
-    inline size_t size() const {
-        return m_size;
-    }
+/**
+ * @brief return a container partitioned around the element a comparison Callable would sort to index n
+ *
+ * Element `n` of the output is the element `sort(c, cmp)` would place there. 
+ * No element before it compares greater, and no element after it compares 
+ * less. The partitioning is an introselect in O(n) on average. If `n` is 
+ * beyond the end of the container the elements are returned unordered.
+ *
+ * @param c container whose elements will be copied and partitioned in the output
+ * @param n index of the element to select
+ * @param cmp a comparison function, defaults to `std::less<>`
+ * @return a partitioned container of elements 
+ */
+template <typename C, typename F = std::less<>>
+auto
+nth(C&& c, size_t n, F&& cmp = F()) {
+    detail::to_vector_t<C> ret(sca::size(c));
+    detail::range_transfer(detail::is_lvalue_ref_t<C>(), ret.begin(), c.begin(), c.end());
 
-    /// return a const_iterator to the beginning of the container subset
-    inline auto begin() const {
-        return m_cbegin;
+    if(n < ret.size()) {
+        std::nth_element(ret.begin(), ret.begin() + n, ret.end(), cmp);
     }
 
-    /// return a const_iterator to the end of the container subset
-    inline auto end() const {
-        return m_cend;
-    }
+    return ret;
+}
 
-private:
-    const size_t m_size;
-    const_iterator m_cbegin;
-    const_iterator m_cend;
-};
+//------------------------------------------------------------------------------
+// string_sort
 
 /**
- * @brief create a `slice_of` object from a container which allows iteration over a subset of another container
- *
- * This implementation only gets selected when the input container is an rvalue.
- * The `slice_of` object will keep the original container in memory as long as 
- * the `slice_of` object exists.
+ * @brief return a container whose strings are sorted in ascending order, comparing 8 cached bytes at a time
  *
- * Typical usecase is to use `auto` as the returned variable's type:
- * ```
- * auto my_slice = sca::slice(my_container, 0, 13);
- * auto my_result = sca::map(my_function, my_slice);
- * ```
+ * A most significant digit radix sort using 8 byte digits: the next 8 bytes 
+ * of every string are read once into an integer array which is radix sorted, 
+ * and only strings sharing those bytes are sorted further on the following 
+ * 8 bytes. Comparisons of long strings with shared prefixes (ie, URLs) do not 
+ * chase every string's heap pointer from the first byte on.
  *
- * Or to use the slice inline:
- * ```
- * auto my_result = sca::map(my_function, sca::slice(my_container, 0, 13));
- * ```
+ * `sort()` selects this algorithm automatically when sorting large containers 
+ * of `std::string` with `std::less<>` or `std::greater<>`.
  *
- * @param idx starting index of the range of values 
- * @param len length of range represented by slice
- * @param c container to take slice of
- * @return a slice object capable of iterating a given container
+ * @param c container of `std::string` which will be copied and sorted in the output
+ * @return a sorted container of strings 
  */
 template <typename C>
 auto
-slice(C&& c, size_t idx, size_t len) {
-    return slice_of<C>(std::forward<C>(c), idx, len);
+string_sort(C&& c) {
+    typedef typename std::decay_t<C>::value_type T;
+    static_assert(std::is_same<T, std::string>::value, "string_sort() requires std::string elements");
+    detail::to_vector_t<C> ret(sca::size(c));
+    detail::range_transfer(detail::is_lvalue_ref_t<C>(), ret.begin(), c.begin(), c.end());
+    detail::string_sort(ret);
+    return ret;
 }
 
-/**
- * @brief create a `const_slice_of` object from a container which allows iteration over a subset of another container
- *
- * This is the const lvalue reference implementation.
- */
-template <typename C>
-auto
-slice(const C& c, size_t idx, size_t len) {
-    return const_slice_of<C>(c, idx, len);
-}
+//------------------------------------------------------------------------------
+// sort_by
 
 /**
- * @brief create a `const_slice_of` object from a container which allows iteration over a subset of another container
+ * @brief return a container whose elements are sorted by a key computed once per element
  *
- * This is the lvalue reference implementation. Must return a `const_slice_of` 
- * in order to prevent inline uses of the slice() from treating the returned 
- * object as an rvalue. If a mutable `slice_of` object is required, call 
- * `mslice()` instead.
+ * Unlike `sort()`, whose comparison Callable is evaluated O(n log n) times, 
+ * the key function is called exactly once per element. The keys are sorted 
+ * alongside the element indices, and the elements are then moved (or copied) 
+ * into their sorted positions once. The sort is stable. 
+ *
+ * Arithmetic keys compared with `std::less<>` or `std::greater<>` are sorted 
+ * with a radix sort.
+ *
+ * @param c container whose elements will be copied and sorted in the output
+ * @param key a function which must accept an element from the container and return a key
+ * @param cmp a comparison function for keys, defaults to `std::less<>`
+ * @return a sorted container of elements 
  */
-template <typename C>
+template <typename C, typename F, typename CMP = std::less<>>
 auto
-slice(C& c, size_t idx, size_t len) {
-    return const_slice_of<C>(c, idx, len);
+sort_by(C&& c, F&& key, CMP&& cmp = CMP()) {
+    typedef std::decay_t<detail::callable_return_t<F, detail::container_reference_value_t<C>>> K;
+    std::vector<K> keys;
+    keys.reserve(sca::size(c));
+
+    for(auto&& e : c) {
+        keys.push_back(key(e));
+    }
+
+    auto idxs = detail::sort_by(detail::is_radix_sort_t<CMP, K>(), keys, cmp);
+    return detail::permute(std::forward<C>(c), idxs);
 }
 
+//------------------------------------------------------------------------------
+// compare 
+
 /**
- * @brief create a mutable `slice_of` object which allows iteration of a subset of another container
+ * @brief return a predicate which is `true` for elements greater than a value 
  *
- * This is the mutable reference implementation of the algorithm, returning a 
- * `slice_of`. This can be dangerous when used inline carelessly, as it will be 
- * treated as an rvalue by algorithms causing unexpected swaps. Best usage is to 
- * explicitly save the result of this method as an lvalue before usage:
+ * Comparison predicates can be passed to any algorithm accepting a predicate.
+ * `filter()` recognizes them and uses vector kernels when filtering a 
+ * contiguous container of arithmetic values:
  * ```
- * auto my_lvalue_slice = sca::mslice(my_container, 0, 13);
- * auto my_result = sca::map(my_function, my_lvalue_slice));
+ * auto my_result = sca::filter(sca::gt(5), my_vector);
  * ```
  *
- * @param idx starting index of the range of values 
- * @param len length of range represented by slice
- * @param c container to take slice of
- * @return a slice object capable of iterating a given container
+ * @param t the value elements are compared to
+ * @return a predicate evaluating `element > t`
  */
-template <typename C>
-auto
-mslice(C&& c, size_t idx, size_t len) {
-    return slice_of<C>(std::forward<C>(c), idx, len);
+template <typename T>
+detail::compare_to<detail::gt_op, T> 
+gt(T t) {
+    return { std::move(t) };
 }
 
-// explicitly catch mutable lvalue reference so compiler doesn't convert to `const C&`
-template <typename C>
-auto
-mslice(C& c, size_t idx, size_t len) {
-    return slice_of<C>(c, idx, len);
+/**
+ * @brief return a predicate which is `true` for elements greater than or equal to a value 
+ * @param t the value elements are compared to
+ * @return a predicate evaluating `element >= t`
+ */
+template <typename T>
+detail::compare_to<detail::ge_op, T> 
+ge(T t) {
+    return { std::move(t) };
 }
 
-//------------------------------------------------------------------------------
-// group
-
 /**
- * @brief assemble a container containing all elements of two or more containers 
- *
- * @param c the first container whose elements should be grouped together with the others
- * @param c2 the second container whose elements should be grouped together with the others
- * @param cs optional, additional containers whose elements should be grouped together with the others
- * @return a container containing all elements of the arguments
+ * @brief return a predicate which is `true` for elements less than a value 
+ * @param t the value elements are compared to
+ * @return a predicate evaluating `element < t`
  */
-template <typename C, typename C2, typename... Cs>
-auto
-group(C&& c, C2&& c2, Cs&&... cs) {
-    detail::to_vector_t<C> ret(detail::sum(sca::size(c), sca::size(c2), sca::size(cs)...));
-    detail::group(ret.begin(), std::forward<C>(c), std::forward<C2>(c2), std::forward<Cs>(cs)...);
-    return ret;
+template <typename T>
+detail::compare_to<detail::lt_op, T> 
+lt(T t) {
+    return { std::move(t) };
 }
 
-//------------------------------------------------------------------------------
-// reverse
-
-/** 
- * @brief return a container where the order of elements is the reverse of the input container
- * @param c an input container 
- * @return a new container with elements reversed from the input container
+/**
+ * @brief return a predicate which is `true` for elements less than or equal to a value 
+ * @param t the value elements are compared to
+ * @return a predicate evaluating `element <= t`
  */
-template <typename C>
-auto
-reverse(C&& c) {
-    detail::to_vector_t<C> ret(sca::size(c));
-    detail::range_transfer(detail::is_lvalue_ref_t<C>(), ret.begin(), c.begin(), c.end());
-    std::reverse(ret.begin(), ret.end());
-    return ret; 
+template <typename T>
+detail::compare_to<detail::le_op, T> 
+le(T t) {
+    return { std::move(t) };
 }
 
-//------------------------------------------------------------------------------
-// sort 
+/**
+ * @brief return a predicate which is `true` for elements equal to a value 
+ * @param t the value elements are compared to
+ * @return a predicate evaluating `element == t`
+ */
+template <typename T>
+detail::compare_to<detail::eq_op, T> 
+eq(T t) {
+    return { std::move(t) };
+}
 
 /**
- * @brief return a container whose elements are sorted based on a comparison Callable
- * @param c container whose elements will be copied and sorted in the output
- * @param cmp a function which must accept two elements from the container and return a boolean
- * @return a sorted container of elements 
+ * @brief return a predicate which is `true` for elements not equal to a value 
+ * @param t the value elements are compared to
+ * @return a predicate evaluating `element != t`
  */
-template <typename C, typename F>
-auto
-sort(C&& c, F&& cmp) {
-    detail::to_vector_t<C> ret(sca::size(c));
-    detail::range_transfer(detail::is_lvalue_ref_t<C>(), ret.begin(), c.begin(), c.end());
-    std::sort(ret.begin(), ret.end(), cmp);
-    return ret;
+template <typename T>
+detail::compare_to<detail::ne_op, T> 
+ne(T t) {
+    return { std::move(t) };
 }
 
 //------------------------------------------------------------------------------
@@ -625,6 +5815,13 @@ sort(C&& c, F&& cmp) {
 
 /**
  * @brief return a filtered container of elements 
+ *
+ * Container c may be a single pass `range_of` (see `range()`).
+ *
+ * Filtering a contiguous container of arithmetic values with a comparison 
+ * predicate (see `gt()`) compacts matching elements with vector kernels 
+ * instead of branching on every element.
+ *
  * @param f a predicate function which gets applied to each element of the input container
  * @param c the input container 
  * @return a container of only the elements for which applying the predicate returned `true`
@@ -632,17 +5829,8 @@ sort(C&& c, F&& cmp) {
 template <typename F, typename C>
 auto
 filter(F&& f, C&& c) {
-    detail::to_vector_t<C> ret(sca::size(c));
-    size_t cur = 0;
-
-    for(auto& e : c) {
-        if(f(e)) {
-            detail::transfer(detail::is_lvalue_ref_t<C>(), ret[cur], e);
-            ++cur;
-        }
-    }
-
-    ret.resize(cur);
+    detail::to_vector_t<C> ret;
+    detail::filter(detail::is_single_pass_t<C>(), detail::is_lvalue_ref_t<C>(), ret, f, c);
     return ret;
 }
 
@@ -660,6 +5848,9 @@ filter(F&& f, C&& c) {
  * Each container can contain a different value type as long as the value type 
  * can be passed to the function.
  *
+ * Container c may be a single pass `range_of` (see `range()`), in which case 
+ * the result grows as c is consumed instead of being sized ahead of time.
+ *
  * @param f a function to call 
  * @param c the first container 
  * @param cs... the remaining containers
@@ -674,8 +5865,8 @@ map(F&& f, C&& c, Cs&&... cs) {
         detail::container_reference_value_t<Cs>...
     > FR;
 
-    std::vector<FR> ret(sca::size(c));
-    detail::map(std::forward<F>(f), ret.begin(), c.begin(), c.end(), cs.begin()...);
+    std::vector<FR> ret;
+    detail::map_into(detail::is_single_pass_t<C>(), ret, std::forward<F>(f), c, cs...);
     return ret;
 }
 
@@ -707,7 +5898,92 @@ map(F&& f, C&& c, Cs&&... cs) {
 template <typename F, typename Result, typename C, typename... Cs>
 auto
 fold(F&& f, Result&& init, C&& c, Cs&&... cs) {
-    return detail::fold(f, std::forward<Result>(init), c.begin(), c.end(), cs.begin()...);
+    return detail::fold(f, std::forward<Result>(init), detail::begin(c), detail::end(c), detail::begin(cs)...);
+}
+
+//------------------------------------------------------------------------------
+// fold_into
+
+/**
+ * @brief update a state in place with the elements of containers grouped by index
+ *
+ * Evaluation ends when every traversible element in container c has been 
+ * iterated. 
+ *
+ * Unlike `fold()`, whose function returns a new value which is moved into the 
+ * state after every element, the argument function must accept a mutable 
+ * reference to the state as its first argument, and the elements of the 
+ * argument containers stored in the current iteration, and update the state 
+ * in place. Its return value is ignored. This avoids a move construction and 
+ * move assignment per element for heavy states (maps, strings, vectors):
+ * ```
+ * auto csv = sca::fold_into([](std::string& s, const std::string& field) { 
+ *     s += field;
+ *     s += ',';
+ * }, std::string(), fields);
+ * ```
+ *
+ * The state is constructed once from `init` (pass an rvalue to move it in) 
+ * and returned when iteration completes.
+ *
+ * @param f the update function 
+ * @param init the initial state
+ * @param c the first container whose elements will update the state
+ * @param cs optional additional containers whose elements will also update the state
+ * @return the final state
+ */
+template <typename F, typename S, typename C, typename... Cs>
+auto
+fold_into(F&& f, S&& init, C&& c, Cs&&... cs) {
+    return detail::fold_into(f, std::forward<S>(init), detail::begin(c), detail::end(c), detail::begin(cs)...);
+}
+
+//------------------------------------------------------------------------------
+// fold_while
+
+/**
+ * @brief update a state in place with the elements of containers grouped by index while a function returns true
+ *
+ * The argument function takes the same arguments as the function passed to 
+ * `fold_into()`, updates the state in place and returns a value convertible 
+ * to `bool`. Evaluation ends when the function returns false, or when every 
+ * traversible element in container c has been iterated. The element for 
+ * which the function returned false has already updated the state. 
+ *
+ * @param f the update function 
+ * @param init the initial state
+ * @param c the first container whose elements will update the state
+ * @param cs optional additional containers whose elements will also update the state
+ * @return the final state
+ */
+template <typename F, typename S, typename C, typename... Cs>
+auto
+fold_while(F&& f, S&& init, C&& c, Cs&&... cs) {
+    return detail::fold_while<true>(f, std::forward<S>(init), detail::begin(c), detail::end(c), detail::begin(cs)...);
+}
+
+/**
+ * @brief update a state in place with the elements of containers grouped by index until a function returns true
+ *
+ * The inverse of `fold_while()`, convenient when the function tests whether 
+ * the result is decided:
+ * ```
+ * auto spent = sca::fold_until([&](long& total, const order& o) { 
+ *     total += o.cost;
+ *     return total > budget;
+ * }, 0L, history);
+ * ```
+ *
+ * @param f the update function 
+ * @param init the initial state
+ * @param c the first container whose elements will update the state
+ * @param cs optional additional containers whose elements will also update the state
+ * @return the final state
+ */
+template <typename F, typename S, typename C, typename... Cs>
+auto
+fold_until(F&& f, S&& init, C&& c, Cs&&... cs) {
+    return detail::fold_while<false>(f, std::forward<S>(init), detail::begin(c), detail::end(c), detail::begin(cs)...);
 }
 
 //------------------------------------------------------------------------------
@@ -731,7 +6007,7 @@ fold(F&& f, Result&& init, C&& c, Cs&&... cs) {
 template <typename F, typename C, typename... Cs>
 void
 each(F&& f, C&& c, Cs&&... cs) {
-    detail::each(f, c.begin(), c.end(), cs.begin()...);
+    detail::each(f, detail::begin(c), detail::end(c), detail::begin(cs)...);
 }
 
 //------------------------------------------------------------------------------
@@ -742,6 +6018,10 @@ each(F&& f, C&& c, Cs&&... cs) {
  *
  * Evaluation ends when traversible element in container c has been iterated. 
  *
+ * A comparison predicate (see `gt()`) applied to a single contiguous container 
+ * of arithmetic values is tested a block of elements at a time with vector 
+ * kernels.
+ *
  * Each container can contain a different value type as long as the value type 
  * can be passed to the function.
  *
@@ -753,7 +6033,7 @@ each(F&& f, C&& c, Cs&&... cs) {
 template <typename F, typename C, typename... Cs>
 bool 
 all(F&& f, C&& c, Cs&&... cs) {
-    return detail::all(f, c.begin(), c.end(), cs.begin()...);
+    return detail::all(f, detail::begin(c), detail::end(c), detail::begin(cs)...);
 }
 
 //------------------------------------------------------------------------------
@@ -764,6 +6044,10 @@ all(F&& f, C&& c, Cs&&... cs) {
  *
  * Evaluation ends when traversible element in container c has been iterated. 
  *
+ * A comparison predicate (see `gt()`) applied to a single contiguous container 
+ * of arithmetic values is tested a block of elements at a time with vector 
+ * kernels.
+ *
  * Each container can contain a different value type as long as the value type 
  * can be passed to the function.
  *
@@ -775,7 +6059,443 @@ all(F&& f, C&& c, Cs&&... cs) {
 template <typename F, typename C, typename... Cs>
 bool 
 some(F&& f, C&& c, Cs&&... cs) {
-    return detail::some(f, c.begin(), c.end(), cs.begin()...);
+    return detail::some(f, detail::begin(c), detail::end(c), detail::begin(cs)...);
+}
+
+//------------------------------------------------------------------------------
+// simd
+
+/// the instruction sets vector kernels can be compiled for
+typedef detail::isa isa;
+
+/**
+ * @brief return the instruction set vector kernels use on the running CPU
+ *
+ * On x86 the vector kernels behind `map()`, `filter()`, `all()`, `some()`, 
+ * `sum()`, `min()`, `max()`, `minmax()`, `dot()`, `map_fold()` and 
+ * `aggregate()` are compiled for SSE4.2, AVX2 and AVX-512. The widest 
+ * instruction set the running CPU supports is detected once and used for 
+ * every subsequent call. Elsewhere the kernels use the instruction set of 
+ * the compilation target (`isa::native`).
+ *
+ * @return the selected instruction set, or `isa::none` if vector kernels are disabled
+ */
+inline isa 
+simd_isa() {
+    return detail::simd_isa();
+}
+
+/**
+ * @brief return the name of an instruction set
+ * @param i an instruction set 
+ * @return a printable name, ie "avx2"
+ */
+inline const char* 
+isa_name(isa i) {
+    switch(i) {
+        case isa::native:
+            return "native";
+        case isa::sse4_2:
+            return "sse4.2";
+        case isa::avx2:
+            return "avx2";
+        case isa::avx512:
+            return "avx512";
+        default:
+            return "none";
+    }
+}
+
+//------------------------------------------------------------------------------
+// reduce
+
+/**
+ * @brief tag type which permits floating point reductions to reorder their arithmetic
+ *
+ * Floating point addition is not associative, so by default `sum()` and 
+ * `dot()` add floating point elements in container order and produce the 
+ * same result as the equivalent `fold()`. Passing `sca::reassociate` as the 
+ * first argument allows these algorithms to split the work across several 
+ * independent vector accumulators, which is much faster but can change the 
+ * result by rounding error.
+ *
+ * Integer reductions are always vectorized, their result is not affected.
+ */
+struct reassociate_t { };
+
+/// instance of `reassociate_t` to pass to reduction algorithms
+constexpr reassociate_t reassociate{};
+
+/**
+ * @brief return the sum of all elements in a container
+ *
+ * Contiguous containers of integers are summed with vector kernels. Integers 
+ * are summed as `int64_t` (`uint64_t` if unsigned) so that narrow elements do 
+ * not wrap. Floating point elements are summed in order unless 
+ * `sca::reassociate` is passed.
+ *
+ * Containers of non-arithmetic types are summed using their `operator+`, 
+ * starting from a value initialized element.
+ *
+ * @param c a container 
+ * @return the sum of all elements, or a value initialized element if c is empty
+ */
+template <typename C>
+auto
+sum(C&& c) {
+    return detail::reduce(detail::is_simd_reduce_t<C, std::false_type>(), detail::add_op(), c);
+}
+
+/**
+ * @brief return the sum of all elements in a container, allowing floating point arithmetic to be reordered 
+ * @param c a container 
+ * @return the sum of all elements, or a value initialized element if c is empty
+ */
+template <typename C>
+auto
+sum(reassociate_t, C&& c) {
+    return detail::reduce(detail::is_simd_reduce_t<C, std::true_type>(), detail::add_op(), c);
+}
+
+/**
+ * @brief return the smallest element in a container
+ *
+ * Contiguous containers of arithmetic types are searched with vector kernels.
+ * The result is unspecified if the container holds a floating point NaN.
+ *
+ * @param c a container 
+ * @return the smallest element, or the largest representable value (infinity for floating point types) if c is empty, or a value initialized element if c is empty and not arithmetic
+ */
+template <typename C>
+auto
+min(C&& c) {
+    return detail::reduce(detail::is_simd_reduce_t<C, std::true_type>(), detail::min_op(), c);
+}
+
+/**
+ * @brief return the largest element in a container
+ *
+ * Contiguous containers of arithmetic types are searched with vector kernels.
+ * The result is unspecified if the container holds a floating point NaN.
+ *
+ * @param c a container 
+ * @return the largest element, or the lowest representable value (negative infinity for floating point types) if c is empty, or a value initialized element if c is empty and not arithmetic
+ */
+template <typename C>
+auto
+max(C&& c) {
+    return detail::reduce(detail::is_simd_reduce_t<C, std::true_type>(), detail::max_op(), c);
+}
+
+/**
+ * @brief return the smallest and largest elements in a container in a single pass
+ *
+ * The result is unspecified if the container holds a floating point NaN.
+ *
+ * @param c a container 
+ * @return a `std::pair` of the values `min(c)` and `max(c)` would return
+ */
+template <typename C>
+auto
+minmax(C&& c) {
+    return detail::minmax(detail::is_simd_reduce_t<C, std::true_type>(), c);
+}
+
+/**
+ * @brief return the sum of the products of the elements of two containers grouped by index 
+ *
+ * Evaluation ends when every element in container c has been iterated. 
+ * Contiguous containers of the same integer type are reduced with vector 
+ * kernels. Integer products are summed as `int64_t` (`uint64_t` if unsigned), 
+ * as with `sum()`. Floating point products are summed in order unless 
+ * `sca::reassociate` is passed.
+ *
+ * @param c the first container 
+ * @param c2 the second container 
+ * @return the sum of `c[i] * c2[i]` for every index i of c
+ */
+template <typename C, typename C2>
+auto
+dot(C&& c, C2&& c2) {
+    typedef std::integral_constant<bool,
+        detail::is_simd_reduce_t<C, std::false_type>::value && 
+        detail::is_simd_reduce_t<C2, std::false_type>::value && 
+        std::is_same<typename std::decay_t<C>::value_type, typename std::decay_t<C2>::value_type>::value> IS_SIMD;
+    return detail::dot(IS_SIMD(), c, c2);
+}
+
+/**
+ * @brief return the sum of the products of the elements of two containers grouped by index, allowing floating point arithmetic to be reordered 
+ * @param c the first container 
+ * @param c2 the second container 
+ * @return the sum of `c[i] * c2[i]` for every index i of c
+ */
+template <typename C, typename C2>
+auto
+dot(reassociate_t, C&& c, C2&& c2) {
+    typedef std::integral_constant<bool,
+        detail::is_simd_reduce_t<C, std::true_type>::value && 
+        detail::is_simd_reduce_t<C2, std::true_type>::value && 
+        std::is_same<typename std::decay_t<C>::value_type, typename std::decay_t<C2>::value_type>::value> IS_SIMD;
+    return detail::dot(IS_SIMD(), c, c2);
+}
+
+//------------------------------------------------------------------------------
+// map_fold
+
+/**
+ * @brief reduce the results of evaluating a function with the elements of containers grouped by index, without storing them
+ *
+ * Equivalent to `sca::fold(g, init, sca::map(f, c, cs...))`, but each result 
+ * of `f` is passed to `g` as soon as it is calculated instead of being stored 
+ * in an intermediate container. 
+ *
+ * When `f` is a standard operator functor (`std::multiplies<>`, etc.) applied 
+ * to two contiguous containers of the same integer type, `g` is an 
+ * associative standard operator functor (`std::plus<>`, `std::multiplies<>`, 
+ * `std::bit_and<>`, `std::bit_or<>` or `std::bit_xor<>`) and `init` has the 
+ * same type, evaluation uses vector kernels. Floating point elements are 
+ * evaluated in order unless `sca::reassociate` is passed.
+ *
+ * @param f the function applied to the elements of each index 
+ * @param g the calculation function accepting the current calculated value and the result of f 
+ * @param init the initial value of the calculation being performed 
+ * @param c the first container whose elements will be passed to f
+ * @param cs optional additional containers whose elements will also be passed to f
+ * @return the final calculated value returned from function g
+ */
+template <typename F, typename G, typename R, typename C, typename... Cs>
+auto
+map_fold(F&& f, G&& g, R&& init, C&& c, Cs&&... cs) {
+    return detail::map_fold(detail::is_simd_map_fold_t<F, G, R, std::false_type, C, Cs...>(), 
+                            f, g, std::forward<R>(init), c, cs...);
+}
+
+/**
+ * @brief reduce the results of evaluating a function with the elements of containers grouped by index, allowing floating point arithmetic to be reordered
+ * @param f the function applied to the elements of each index 
+ * @param g the calculation function accepting the current calculated value and the result of f 
+ * @param init the initial value of the calculation being performed 
+ * @param c the first container whose elements will be passed to f
+ * @param cs optional additional containers whose elements will also be passed to f
+ * @return the final calculated value returned from function g
+ */
+template <typename F, typename G, typename R, typename C, typename... Cs>
+auto
+map_fold(reassociate_t, F&& f, G&& g, R&& init, C&& c, Cs&&... cs) {
+    return detail::map_fold(detail::is_simd_map_fold_t<F, G, R, std::true_type, C, Cs...>(), 
+                            f, g, std::forward<R>(init), c, cs...);
+}
+
+/**
+ * @brief reduce the results of evaluating a function with the elements of containers grouped by index, using several threads
+ *
+ * Random access containers are split into one index range per hardware 
+ * thread. Each range is reduced with `g` from its first result of `f`, and 
+ * the partial results are then reduced in order starting from `init`, so 
+ * `g` must be associative and accept two results. Like `sca::reassociate` 
+ * this can change floating point results by rounding error, and ranges 
+ * eligible for vector kernels use them whatever their element type. Other 
+ * containers, and containers too small to be worth splitting, are evaluated 
+ * as by `map_fold()`.
+ *
+ * @param f the function applied to the elements of each index, which must be safe to call concurrently
+ * @param g the associative calculation function accepting the current calculated value and the result of f 
+ * @param init the initial value of the calculation being performed 
+ * @param c the first container whose elements will be passed to f
+ * @param cs optional additional containers whose elements will also be passed to f
+ * @return the final calculated value returned from function g
+ */
+template <typename F, typename G, typename R, typename C, typename... Cs>
+auto
+map_fold(parallel_t, F&& f, G&& g, R&& init, C&& c, Cs&&... cs) {
+    typedef detail::is_random_access_t<decltype(detail::begin(c)), decltype(detail::begin(cs))...> RANDOM_ACCESS;
+    return detail::parallel_map_fold(RANDOM_ACCESS(), detail::is_simd_map_fold_t<F, G, R, std::true_type, C, Cs...>(), 
+                                     f, g, std::forward<R>(init), detail::parallel_workers(c, RANDOM_ACCESS()), c, cs...);
+}
+
+//------------------------------------------------------------------------------
+// histogram
+
+/**
+ * @brief return the count of elements of a container falling into each of a number of equal width bins
+ *
+ * Bin `i` counts the elements in `[lo + i * w, lo + (i + 1) * w)` where 
+ * `w = (hi - lo) / bins`, except the last bin also counts elements equal to 
+ * `hi`. Elements outside of `[lo, hi]` are not counted.
+ *
+ * @param c a container of arithmetic elements
+ * @param bins the count of bins 
+ * @param lo the lower bound of the first bin
+ * @param hi the upper bound of the last bin
+ * @return a container of `bins` counts
+ */
+template <typename C>
+std::vector<size_t>
+histogram(C&& c, size_t bins, double lo, double hi) {
+    std::vector<size_t> counts(bins, 0);
+
+    if(!bins || !(lo <= hi)) {
+        return counts;
+    }
+
+    const double scale = hi > lo ? double(bins) / (hi - lo) : 0.0;
+
+    for(auto&& e : c) {
+        const double x = double(e);
+
+        if(x >= lo && x <= hi) {
+            ++counts[std::min(size_t((x - lo) * scale), bins - 1)];
+        }
+    }
+
+    return counts;
+}
+
+/**
+ * @brief return the count of elements of a container falling into each of a number of equal width bins spanning the elements
+ *
+ * The bins span from the smallest to the largest element, which are found 
+ * with `minmax()`.
+ *
+ * @param c a container of arithmetic elements
+ * @param bins the count of bins 
+ * @return a container of `bins` counts
+ */
+template <typename C>
+std::vector<size_t>
+histogram(C&& c, size_t bins) {
+    if(!sca::size(c)) {
+        return std::vector<size_t>(bins, 0);
+    }
+
+    const auto mm = sca::minmax(c);
+    return sca::histogram(c, bins, double(mm.first), double(mm.second));
+}
+
+//------------------------------------------------------------------------------
+// aggregate
+
+/**
+ * Accumulators computing a result from every element of a container, passed to `aggregate()`.
+ *
+ * An accumulator is any object providing the const member functions:
+ * - `template <typename T> S init()` - return the initial state when aggregating elements of type `T`
+ * - `add(S& s, const T& t)` - update state `s` with element `t`
+ * - `result(const S& s, size_t n)` - return the result from the final state and the count of elements
+ */
+namespace agg {
+
+/// accumulator of the sum of all elements, integers are summed as `int64_t` or `uint64_t` like `sum()`
+struct sum_t : detail::simd_agg<detail::add_op> {
+    template <typename T> 
+    detail::reduce_value_t<detail::add_op, T> init() const { return detail::reduce_value_t<detail::add_op, T>(); }
+
+    template <typename S, typename T> 
+    void add(S& s, const T& t) const { s = std::move(s) + t; }
+
+    template <typename S> 
+    S result(const S& s, size_t) const { return s; }
+};
+
+/// accumulator of the smallest arithmetic element, or the largest representable value if there are no elements
+struct min_t : detail::simd_agg<detail::min_op> {
+    template <typename T> 
+    T init() const { return detail::identity<T>(detail::min_op()); }
+
+    template <typename S, typename T> 
+    void add(S& s, const T& t) const { s = detail::min_op()(s, S(t)); }
+
+    template <typename S> 
+    S result(const S& s, size_t) const { return s; }
+};
+
+/// accumulator of the largest arithmetic element, or the lowest representable value if there are no elements
+struct max_t : detail::simd_agg<detail::max_op> {
+    template <typename T> 
+    T init() const { return detail::identity<T>(detail::max_op()); }
+
+    template <typename S, typename T> 
+    void add(S& s, const T& t) const { s = detail::max_op()(s, S(t)); }
+
+    template <typename S> 
+    S result(const S& s, size_t) const { return s; }
+};
+
+/// accumulator of the count of elements
+struct count_t : detail::simd_agg<detail::keep_op> {
+    template <typename T> 
+    size_t init() const { return 0; }
+
+    template <typename S, typename T> 
+    void add(S&, const T&) const { }
+
+    template <typename S> 
+    size_t result(const S&, size_t n) const { return n; }
+};
+
+/// accumulator of the arithmetic mean of all elements as a `double`, NaN if there are no elements
+struct mean_t : detail::simd_agg<detail::add_op> {
+    // integers are summed as 64 bit integers, `float`s as `double`s
+    template <typename T> 
+    using state_t = std::conditional_t<std::is_same<T, float>::value, double, detail::reduce_value_t<detail::add_op, T>>;
+
+    template <typename T> 
+    state_t<T> init() const { return state_t<T>(); }
+
+    template <typename S, typename T> 
+    void add(S& s, const T& t) const { s = std::move(s) + t; }
+
+    template <typename S> 
+    double result(const S& s, size_t n) const { return double(s) / double(n); }
+};
+
+/// instances of the built-in accumulators 
+constexpr sum_t sum{};
+constexpr min_t min{};
+constexpr max_t max{};
+constexpr count_t count{};
+constexpr mean_t mean{};
+
+}
+
+/**
+ * @brief return the results of several accumulators computed in a single pass over a container
+ *
+ * When every accumulator is built-in (`sca::agg::sum`, `sca::agg::min`, 
+ * `sca::agg::max`, `sca::agg::count` and `sca::agg::mean`) and the container 
+ * is contiguous and arithmetic, all accumulators are updated from the same 
+ * vector loads. As with `sum()`, floating point sums and means are computed in 
+ * order unless `sca::reassociate` is passed. Integers are summed as `int64_t` 
+ * or `uint64_t` and `float` means are accumulated as `double`s, so narrow 
+ * elements do not overflow or lose precision.
+ *
+ * Any other accumulator is updated with each element in order. 
+ *
+ * @param c a container 
+ * @param a an accumulator
+ * @param as the remaining accumulators
+ * @return a `std::tuple` of the results of each accumulator, in argument order
+ */
+template <typename C, typename A, typename... As>
+auto
+aggregate(C&& c, A&& a, As&&... as) {
+    return detail::aggregate(detail::is_simd_aggregate_t<C, std::false_type, A, As...>(), 
+                             c, std::index_sequence_for<A, As...>(), a, as...);
+}
+
+/**
+ * @brief return the results of several accumulators computed in a single pass over a container, allowing floating point arithmetic to be reordered
+ * @param c a container 
+ * @param a an accumulator
+ * @param as the remaining accumulators
+ * @return a `std::tuple` of the results of each accumulator, in argument order
+ */
+template <typename C, typename A, typename... As>
+auto
+aggregate(reassociate_t, C&& c, A&& a, As&&... as) {
+    return detail::aggregate(detail::is_simd_aggregate_t<C, std::true_type, A, As...>(), 
+                             c, std::index_sequence_for<A, As...>(), a, as...);
 }
 
 }
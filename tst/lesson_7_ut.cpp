@@ -2,6 +2,14 @@
 #include <vector>
 #include <list>
 #include <forward_list>
+#include <sstream>
+#include <iterator>
+#include <numeric>
+#include <limits>
+#include <cmath>
+#include <unordered_map>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
@@ -216,3 +224,1632 @@ TEST(lesson_7, some) {
         EXPECT_FALSE(out);
     }
 }
+
+TEST(lesson_7, range) {
+    {
+        std::istringstream ss("1 2 3 4 5 6");
+        auto r = sca::range(std::istream_iterator<int>(ss), std::istream_iterator<int>());
+        auto out = sca::map([](int i) { return i * 2; }, r);
+        auto is_same = std::is_same<std::vector<int>,decltype(out)>::value;
+        EXPECT_TRUE(is_same);
+        EXPECT_EQ(std::vector<int>({2,4,6,8,10,12}), out);
+    }
+
+    {
+        std::istringstream ss("1 2 3 4 5 6");
+        const std::vector<int> v{6,5,4,3,2,1};
+        auto r = sca::range(std::istream_iterator<int>(ss), std::istream_iterator<int>());
+        auto out = sca::map([](int a, int b) { return a * b; }, r, v);
+        EXPECT_EQ(std::vector<int>({6,10,12,12,10,6}), out);
+    }
+
+    {
+        std::istringstream ss("1 2 3 4 5 6");
+        auto r = sca::range(std::istream_iterator<int>(ss), std::istream_iterator<int>());
+        auto out = sca::filter([](int i) { return i % 2 == 0; }, r);
+        EXPECT_EQ(std::vector<int>({2,4,6}), out);
+    }
+
+    {
+        std::istringstream ss("I am a stick");
+        auto r = sca::range(std::istream_iterator<std::string>(ss), std::istream_iterator<std::string>());
+        auto concatenate = [](std::string cur, const std::string& s) { return cur + s; };
+        auto out = sca::fold(concatenate, std::string(""), r);
+        EXPECT_EQ(std::string("Iamastick"), out);
+    }
+
+    {
+        std::istringstream ss("1 2 3 4 5 6");
+        auto r = sca::range(std::istream_iterator<int>(ss), std::istream_iterator<int>());
+        int sum = 0;
+        sca::each([&](int i) { sum += i; }, r);
+        EXPECT_EQ(21, sum);
+    }
+
+    {
+        // multi pass iterators can be wrapped too
+        const std::list<int> l{1,2,3,4};
+        auto out = sca::map([](int i) { return i + 1; }, sca::range(l.begin(), l.end()));
+        EXPECT_EQ(std::vector<int>({2,3,4,5}), out);
+    }
+}
+
+TEST(lesson_7, random_access) {
+    const std::vector<int> v{1,2,3,4};
+    const std::vector<int> v2{5,6,7,8};
+    const std::list<int> l{9,10,11,12};
+
+    {
+        auto has_data = sca::detail::has_data<const std::vector<int>>::value;
+        EXPECT_TRUE(has_data);
+        has_data = sca::detail::has_data<std::list<int>>::value;
+        EXPECT_FALSE(has_data);
+        has_data = sca::detail::has_data<std::vector<bool>>::value;
+        EXPECT_FALSE(has_data);
+
+        auto is_ra = sca::detail::is_random_access_t<int*, std::vector<int>::iterator>::value;
+        EXPECT_TRUE(is_ra);
+        is_ra = sca::detail::is_random_access_t<int*, std::list<int>::iterator>::value;
+        EXPECT_FALSE(is_ra);
+    }
+
+    {
+        // every input is random access 
+        auto out = sca::map([](int a, int b) { return a + b; }, v, v2);
+        EXPECT_EQ(std::vector<int>({6,8,10,12}), out);
+
+        auto sum = sca::fold([](int cur, int a, int b) { return cur + a * b; }, 0, v, v2);
+        EXPECT_EQ(70, sum);
+
+        std::vector<int> seen;
+        sca::each([&](int a, int b) { seen.push_back(b - a); }, v, v2);
+        EXPECT_EQ(std::vector<int>({4,4,4,4}), seen);
+
+        EXPECT_TRUE(sca::all([](int a, int b) { return a < b; }, v, v2));
+        EXPECT_FALSE(sca::some([](int a, int b) { return a > b; }, v, v2));
+    }
+
+    {
+        // mixing in a bidirectional container falls back to stepping iterators
+        auto out = sca::map([](int a, int b, int c) { return a + b + c; }, v, v2, l);
+        EXPECT_EQ(std::vector<int>({15,18,21,24}), out);
+    }
+
+    {
+        // std::vector<bool> has no data() and returns proxies from its iterators
+        const std::vector<bool> vb{true, false, true};
+        auto out = sca::map([](bool b) { return !b; }, vb);
+        EXPECT_EQ(std::vector<bool>({false, true, false}), out);
+    }
+}
+
+TEST(lesson_7, simd_map) {
+    {
+        auto is_simd = sca::detail::is_simd_map_t<std::plus<int>, int*, const int*, const int*>::value;
+        EXPECT_EQ(SCA_SIMD == 1, is_simd);
+        is_simd = sca::detail::is_simd_map_t<std::plus<>, float*, float*, const float*>::value;
+        EXPECT_EQ(SCA_SIMD == 1, is_simd);
+        is_simd = sca::detail::is_simd_map_t<std::divides<int>, int*, const int*, const int*>::value;
+        EXPECT_FALSE(is_simd);
+        is_simd = sca::detail::is_simd_map_t<std::bit_xor<>, double*, const double*, const double*>::value;
+        EXPECT_FALSE(is_simd);
+        is_simd = sca::detail::is_simd_map_t<std::plus<long>, long*, const int*, const int*>::value;
+        EXPECT_FALSE(is_simd);
+    }
+
+    // exercise full vectors as well as the scalar remainder
+    for(size_t len : {0, 1, 7, 8, 31, 64, 67}) {
+        std::vector<int> a(len);
+        std::vector<int> b(len);
+        std::vector<float> fa(len);
+        std::vector<float> fb(len);
+
+        for(size_t i = 0; i < len; ++i) {
+            a[i] = (int)i * 3 - 20;
+            b[i] = (int)i + 1;
+            fa[i] = (float)i * 0.5f;
+            fb[i] = (float)i + 1.0f;
+        }
+
+        auto add = sca::map(std::plus<int>(), a, b);
+        auto sub = sca::map(std::minus<>(), a, b);
+        auto mul = sca::map(std::multiplies<int>(), a, b);
+        auto bxor = sca::map(std::bit_xor<int>(), a, b);
+        auto fdiv = sca::map(std::divides<float>(), fa, fb);
+        auto idiv = sca::map(std::divides<int>(), a, b);
+
+        ASSERT_EQ(len, add.size());
+        ASSERT_EQ(len, fdiv.size());
+
+        for(size_t i = 0; i < len; ++i) {
+            EXPECT_EQ(a[i] + b[i], add[i]);
+            EXPECT_EQ(a[i] - b[i], sub[i]);
+            EXPECT_EQ(a[i] * b[i], mul[i]);
+            EXPECT_EQ(a[i] ^ b[i], bxor[i]);
+            EXPECT_EQ(a[i] / b[i], idiv[i]);
+            EXPECT_FLOAT_EQ(fa[i] / fb[i], fdiv[i]);
+        }
+    }
+
+    {
+        // small integers wrap the same way their scalar conversions do
+        const std::vector<short> s{32767, -32768, 100, 3};
+        auto out = sca::map(std::plus<short>(), s, s);
+        auto is_same = std::is_same<std::vector<short>,decltype(out)>::value;
+        EXPECT_TRUE(is_same);
+
+        for(size_t i = 0; i < s.size(); ++i) {
+            EXPECT_EQ((short)(s[i] + s[i]), out[i]);
+        }
+    }
+}
+
+TEST(lesson_7, reduce) {
+    for(size_t len : {1, 5, 16, 33, 100, 1027}) {
+        std::vector<int> v(len);
+        std::vector<double> dv(len);
+
+        for(size_t i = 0; i < len; ++i) {
+            v[i] = (int)((i * 7919) % 1000) - 500;
+            dv[i] = 1.0 / (double)(i + 1);
+        }
+
+        EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), sca::sum(v));
+        EXPECT_EQ(*std::min_element(v.begin(), v.end()), sca::min(v));
+        EXPECT_EQ(*std::max_element(v.begin(), v.end()), sca::max(v));
+
+        auto mm = sca::minmax(v);
+        EXPECT_EQ(sca::min(v), mm.first);
+        EXPECT_EQ(sca::max(v), mm.second);
+
+        EXPECT_EQ(std::inner_product(v.begin(), v.end(), v.begin(), 0), sca::dot(v, v));
+
+        // floating point is summed in order unless reassociation is requested
+        const double ordered = std::accumulate(dv.begin(), dv.end(), 0.0);
+        EXPECT_EQ(ordered, sca::sum(dv));
+        EXPECT_NEAR(ordered, sca::sum(sca::reassociate, dv), 1e-9);
+
+        const double ordered_dot = std::inner_product(dv.begin(), dv.end(), dv.begin(), 0.0);
+        EXPECT_EQ(ordered_dot, sca::dot(dv, dv));
+        EXPECT_NEAR(ordered_dot, sca::dot(sca::reassociate, dv, dv), 1e-9);
+
+        EXPECT_EQ(*std::min_element(dv.begin(), dv.end()), sca::min(dv));
+        EXPECT_EQ(*std::max_element(dv.begin(), dv.end()), sca::max(dv));
+    }
+
+    {
+        // empty containers return the identity of the reduction
+        const std::vector<int> v;
+        const std::vector<float> fv;
+        EXPECT_EQ(0, sca::sum(v));
+        EXPECT_EQ(std::numeric_limits<int>::max(), sca::min(v));
+        EXPECT_EQ(std::numeric_limits<int>::lowest(), sca::max(v));
+        EXPECT_EQ(std::numeric_limits<float>::infinity(), sca::min(fv));
+        EXPECT_EQ(-std::numeric_limits<float>::infinity(), sca::max(fv));
+    }
+
+    {
+        // non-contiguous and non-arithmetic containers
+        const std::list<int> l{3, -2, 9, 4};
+        EXPECT_EQ(14, sca::sum(l));
+        EXPECT_EQ(-2, sca::min(l));
+        EXPECT_EQ(9, sca::max(l));
+        EXPECT_EQ(110, sca::dot(l, l));
+
+        const std::vector<std::string> v{"I", " am", " a", " stick"};
+        EXPECT_EQ(std::string("I am a stick"), sca::sum(v));
+        EXPECT_EQ(std::string(" a"), sca::min(v));
+        EXPECT_EQ(std::string("I"), sca::max(v));
+
+        // there is no largest or lowest string
+        const std::vector<std::string> empty;
+        EXPECT_EQ(std::string(), sca::min(empty));
+        EXPECT_EQ(std::string(), sca::max(empty));
+        EXPECT_EQ(std::string(), sca::minmax(empty).second);
+    }
+
+    // narrow integers are summed in 64 bits, at every vector width and in the scalar tail
+    for(size_t len : {2, 15, 100, 1000, 4099}) {
+        const std::vector<uint8_t> u8(len, 200);
+        const std::vector<int8_t> s8(len, -100);
+        const std::vector<uint16_t> u16(len, 60000);
+        const std::vector<int16_t> s16(len, -30000);
+        const std::vector<int32_t> s32(len, -2000000000);
+        const std::vector<uint32_t> u32(len, 4000000000u);
+        const int64_t n = int64_t(len);
+
+        EXPECT_EQ(uint64_t(200 * n), sca::sum(u8));
+        EXPECT_EQ(-100 * n, sca::sum(s8));
+        EXPECT_EQ(uint64_t(60000 * n), sca::sum(u16));
+        EXPECT_EQ(-30000 * n, sca::sum(s16));
+        EXPECT_EQ(-2000000000 * n, sca::sum(s32));
+        EXPECT_EQ(uint64_t(4000000000 * n), sca::sum(u32));
+        EXPECT_EQ(uint64_t(200 * n), sca::sum(sca::reassociate, u8));
+
+        EXPECT_EQ(uint64_t(40000 * n), sca::dot(u8, u8));
+        EXPECT_EQ(10000 * n, sca::dot(s8, s8));
+        EXPECT_EQ(uint64_t(3600000000 * n), sca::dot(u16, u16));
+        EXPECT_EQ(900000000 * n, sca::dot(s16, s16));
+        EXPECT_EQ(-2000000000 * n * 20000, sca::dot(s32, std::vector<int32_t>(len, 20000)));
+    }
+
+    {
+        // mixed signs and values within a vector
+        std::vector<int8_t> v;
+        for(int i = 0; i < 1001; ++i) {
+            v.push_back(int8_t(i * 37));
+        }
+
+        int64_t expected = 0;
+        int64_t expected_dot = 0;
+        for(int8_t i : v) {
+            expected += i;
+            expected_dot += int64_t(i) * i;
+        }
+
+        EXPECT_EQ(expected, sca::sum(v));
+        EXPECT_EQ(expected, sca::sum(std::list<int8_t>(v.begin(), v.end())));
+        EXPECT_EQ(expected_dot, sca::dot(v, v));
+        EXPECT_EQ(expected_dot, sca::dot(std::list<int8_t>(v.begin(), v.end()), v));
+    }
+}
+
+TEST(lesson_7, compare) {
+    {
+        auto is_simd = sca::detail::is_simd_filter_t<decltype(sca::gt(5)), std::vector<int>&>::value;
+        EXPECT_EQ(SCA_SIMD == 1, is_simd);
+        is_simd = sca::detail::is_simd_filter_t<decltype(sca::gt(5)), const std::vector<double>&>::value;
+        EXPECT_EQ(SCA_SIMD == 1, is_simd);
+        is_simd = sca::detail::is_simd_filter_t<decltype(sca::gt(5.5)), std::vector<int>&>::value;
+        EXPECT_FALSE(is_simd);
+        is_simd = sca::detail::is_simd_filter_t<decltype(sca::gt(5)), std::list<int>&>::value;
+        EXPECT_FALSE(is_simd);
+    }
+
+    {
+        EXPECT_TRUE(sca::gt(3)(4));
+        EXPECT_FALSE(sca::gt(3)(3));
+        EXPECT_TRUE(sca::ge(3)(3));
+        EXPECT_TRUE(sca::lt(3)(2));
+        EXPECT_TRUE(sca::le(3)(3));
+        EXPECT_TRUE(sca::eq(std::string("a"))(std::string("a")));
+        EXPECT_TRUE(sca::ne(3)(2));
+    }
+
+    for(size_t len : {0, 3, 8, 19, 64, 1001}) {
+        std::vector<int> v(len);
+        std::vector<float> fv(len);
+
+        for(size_t i = 0; i < len; ++i) {
+            v[i] = (int)((i * 7919) % 100);
+            fv[i] = (float)v[i] * 0.5f;
+        }
+
+        auto expect = [](const std::vector<int>& c, std::function<bool(int)> f) {
+            std::vector<int> ret;
+            std::copy_if(c.begin(), c.end(), std::back_inserter(ret), f);
+            return ret;
+        };
+
+        EXPECT_EQ(expect(v, [](int i) { return i > 50; }), sca::filter(sca::gt(50), v));
+        EXPECT_EQ(expect(v, [](int i) { return i >= 50; }), sca::filter(sca::ge(50), v));
+        EXPECT_EQ(expect(v, [](int i) { return i < 5; }), sca::filter(sca::lt(5), v));
+        EXPECT_EQ(expect(v, [](int i) { return i <= 5; }), sca::filter(sca::le(5), v));
+        EXPECT_EQ(expect(v, [](int i) { return i == 7; }), sca::filter(sca::eq(7), v));
+        EXPECT_EQ(expect(v, [](int i) { return i != 7; }), sca::filter(sca::ne(7), v));
+        EXPECT_EQ(expect(v, [](int) { return true; }), sca::filter(sca::ge(0), v));
+        EXPECT_EQ(expect(v, [](int) { return false; }), sca::filter(sca::gt(100), v));
+
+        // comparisons which would not happen in the element type use the plain loop
+        EXPECT_EQ(expect(v, [](int i) { return i > 50.5; }), sca::filter(sca::gt(50.5), v));
+
+        auto fout = sca::filter(sca::gt(25), fv);
+        auto is_same = std::is_same<std::vector<float>,decltype(fout)>::value;
+        EXPECT_TRUE(is_same);
+        EXPECT_EQ(sca::filter([](float f) { return f > 25; }, fv), fout);
+    }
+
+    {
+        const std::list<std::string> l{"I", "am", "a", "stick"};
+        EXPECT_EQ(std::vector<std::string>({"I", "a"}), sca::filter(sca::lt(std::string("am")), l));
+    }
+}
+
+namespace lesson_7_ns {
+
+/*
+ * Filter blocks of 64 elements which all match, none match, or match at 
+ * random with every vector kernel the CPU can execute, covering whole 
+ * vectors of each kind at every vector width.
+ */
+template <typename T>
+void filter_kernel_widths() {
+#if SCA_SIMD
+    for(size_t len : {64, 200, 1000}) {
+        std::vector<T> v(len);
+
+        for(size_t i = 0; i < len; ++i) {
+            const size_t block = (i / 64) % 3;
+            v[i] = block == 0 ? T(20) : block == 1 ? T(0) : T((i * 7919) % 13);
+        }
+
+        std::vector<T> expect;
+        std::copy_if(v.begin(), v.end(), std::back_inserter(expect), [](T t) { return t > T(6); });
+
+        for(auto i : {sca::isa::native, sca::isa::sse4_2, sca::isa::avx2, sca::isa::avx512}) {
+            if(!sca::detail::cpu_supports(i)) {
+                continue;
+            }
+
+            std::vector<T> out(len);
+            out.resize(sca::detail::simd_run<sca::detail::filter_kernel>(i, sca::detail::gt_op(), T(6), v.data(), len, out.data()));
+            EXPECT_EQ(expect, out) << sca::isa_name(i) << " " << sizeof(T);
+        }
+    }
+#endif
+}
+
+}
+
+TEST(lesson_7, filter_kernel_widths) {
+    lesson_7_ns::filter_kernel_widths<int8_t>();
+    lesson_7_ns::filter_kernel_widths<uint8_t>();
+    lesson_7_ns::filter_kernel_widths<int16_t>();
+    lesson_7_ns::filter_kernel_widths<int32_t>();
+    lesson_7_ns::filter_kernel_widths<uint32_t>();
+    lesson_7_ns::filter_kernel_widths<int64_t>();
+    lesson_7_ns::filter_kernel_widths<float>();
+    lesson_7_ns::filter_kernel_widths<double>();
+
+    // `long double` has no vector lanes and is filtered element by element
+    EXPECT_FALSE(sca::detail::is_simd_value<long double>::value);
+    const std::vector<long double> v{1.0L, 4.5L, 3.0L, 7.0L};
+    EXPECT_EQ(std::vector<long double>({4.5L, 7.0L}), sca::filter(sca::gt(3.0L), v));
+}
+
+TEST(lesson_7, simd_all_some) {
+    {
+        auto is_simd = sca::detail::is_simd_scan_t<decltype(sca::gt(5)), const int*>::value;
+        EXPECT_EQ(SCA_SIMD == 1, is_simd);
+        is_simd = sca::detail::is_simd_scan_t<decltype(sca::gt(5)), const int*, const int*>::value;
+        EXPECT_FALSE(is_simd);
+        is_simd = sca::detail::is_simd_scan_t<std::function<bool(int)>, const int*>::value;
+        EXPECT_FALSE(is_simd);
+    }
+
+    for(size_t len : {0, 1, 15, 16, 64, 65, 300}) {
+        std::vector<int> v(len);
+        std::vector<double> dv(len);
+
+        for(size_t i = 0; i < len; ++i) {
+            v[i] = (int)i;
+            dv[i] = (double)i;
+        }
+
+        EXPECT_TRUE(sca::all(sca::ge(0), v));
+        EXPECT_EQ(len <= 1, sca::all(sca::lt(1), v));
+        EXPECT_FALSE(sca::some(sca::lt(0), v));
+        EXPECT_TRUE(sca::all(sca::ge(0.0), dv));
+        EXPECT_FALSE(sca::some(sca::lt(0.0), dv));
+
+        // a single differing element is found anywhere in the container
+        for(size_t i = 0; i < len; ++i) {
+            auto cpv = v;
+            cpv[i] = -1;
+            EXPECT_FALSE(sca::all(sca::ge(0), cpv));
+            EXPECT_TRUE(sca::some(sca::eq(-1), cpv));
+            EXPECT_TRUE(sca::some(sca::lt(0), cpv));
+            EXPECT_TRUE(sca::all(sca::ne(-2), cpv));
+        }
+    }
+}
+
+TEST(lesson_7, simd_dispatch) {
+    const sca::isa chosen = sca::simd_isa();
+    EXPECT_EQ(chosen, sca::simd_isa());
+    EXPECT_TRUE(sca::detail::cpu_supports(chosen));
+    EXPECT_EQ(SCA_SIMD == 0, chosen == sca::isa::none);
+    EXPECT_EQ(std::string("avx2"), sca::isa_name(sca::isa::avx2));
+
+#if SCA_SIMD
+    std::vector<int> v(1000);
+    std::vector<int> v2(1000);
+
+    for(size_t i = 0; i < v.size(); ++i) {
+        v[i] = (int)((i * 7919) % 100);
+        v2[i] = (int)i;
+    }
+
+    const int expect_sum = std::accumulate(v.begin(), v.end(), 0);
+    const size_t expect_count = std::count_if(v.begin(), v.end(), [](int i) { return i > 50; });
+
+    // every kernel variant the CPU can execute produces the same results
+    for(auto i : {sca::isa::native, sca::isa::sse4_2, sca::isa::avx2, sca::isa::avx512}) {
+        if(!sca::detail::cpu_supports(i)) {
+            continue;
+        }
+
+        EXPECT_EQ(expect_sum, sca::detail::simd_run<sca::detail::reduce_kernel>(i, sca::detail::add_op(), v.data(), v.size())) << sca::isa_name(i);
+        EXPECT_EQ(99, sca::detail::simd_run<sca::detail::reduce_kernel>(i, sca::detail::max_op(), v.data(), v.size())) << sca::isa_name(i);
+
+        std::vector<int> out(v.size());
+        sca::detail::simd_run<sca::detail::map_kernel>(i, sca::detail::add_op(), out.data(), v.data(), v2.data(), v.size());
+        EXPECT_EQ(sca::map([](int a, int b) { return a + b; }, v, v2), out) << sca::isa_name(i);
+
+        const size_t count = sca::detail::simd_run<sca::detail::filter_kernel>(i, sca::detail::gt_op(), 50, v.data(), v.size(), out.data());
+        EXPECT_EQ(expect_count, count) << sca::isa_name(i);
+
+        EXPECT_TRUE(sca::detail::simd_run<sca::detail::scan_kernel<false>>(i, sca::detail::eq_op(), 99, v.data(), v.size())) << sca::isa_name(i);
+        EXPECT_FALSE(sca::detail::simd_run<sca::detail::scan_kernel<true>>(i, sca::detail::lt_op(), 99, v.data(), v.size())) << sca::isa_name(i);
+    }
+#endif
+}
+
+TEST(lesson_7, soa_vector) {
+    sca::soa_vector<int, double, std::string> soa;
+    EXPECT_TRUE(soa.empty());
+
+    soa.push_back(std::make_tuple(1, 0.5, std::string("one")));
+    soa.push_back(std::make_tuple(2, 4.5, std::string("two")));
+    soa.emplace_back(3, 1.5, "three");
+    soa.emplace_back(4, 9.5, "four");
+    EXPECT_EQ(4, soa.size());
+    EXPECT_EQ(4, sca::size(soa));
+
+    {
+        // columns are plain vectors
+        auto is_same = std::is_same<std::vector<double>&,decltype(soa.column<1>())>::value;
+        EXPECT_TRUE(is_same);
+        EXPECT_EQ(std::vector<int>({1,2,3,4}), soa.column<0>());
+        EXPECT_EQ(10, sca::sum(soa.column<0>()));
+        EXPECT_EQ(std::vector<double>({4.5, 9.5}), sca::filter(sca::gt(2.0), soa.column<1>()));
+    }
+
+    {
+        // rows are proxies referencing each column
+        auto row = soa[1];
+        EXPECT_EQ(2, std::get<0>(row));
+        EXPECT_EQ(std::string("two"), std::get<2>(row));
+        std::get<0>(row) = 20;
+        EXPECT_EQ(20, soa.column<0>()[1]);
+        std::get<0>(soa[1]) = 2;
+
+        const auto& csoa = soa;
+        EXPECT_EQ(4.5, std::get<1>(csoa[1]));
+    }
+
+    {
+        // rows can be passed to algorithms
+        auto out = sca::map([](std::tuple<int&, double&, std::string&> r) { 
+            return std::get<2>(r) + std::to_string(std::get<0>(r)); 
+        }, soa);
+        EXPECT_EQ(std::vector<std::string>({"one1", "two2", "three3", "four4"}), out);
+
+        auto total = sca::fold([](double cur, std::tuple<const int&, const double&, const std::string&> r) {
+            return cur + std::get<0>(r) * std::get<1>(r);
+        }, 0.0, static_cast<const decltype(soa)&>(soa));
+        EXPECT_EQ(0.5 + 9.0 + 4.5 + 38.0, total);
+
+        auto rows = sca::filter([](std::tuple<int&, double&, std::string&> r) { return std::get<0>(r) % 2 == 0; }, soa);
+        auto is_same = std::is_same<std::vector<std::tuple<int, double, std::string>>,decltype(rows)>::value;
+        EXPECT_TRUE(is_same);
+        ASSERT_EQ(2, rows.size());
+        EXPECT_EQ(std::string("four"), std::get<2>(rows[1]));
+        EXPECT_EQ(std::string("four"), soa.column<2>()[3]);
+    }
+
+    {
+        // filter one column, then gather the others
+        auto idxs = sca::where(sca::gt(2.0), soa.column<1>());
+        EXPECT_EQ(std::vector<size_t>({1, 3}), idxs);
+
+        EXPECT_EQ(std::vector<std::string>({"two", "four"}), sca::gather(soa.column<2>(), idxs));
+
+        auto selected = soa.gather(idxs);
+        EXPECT_EQ(2, selected.size());
+        EXPECT_EQ(std::vector<int>({2, 4}), selected.column<0>());
+        EXPECT_EQ(std::vector<double>({4.5, 9.5}), selected.column<1>());
+        EXPECT_EQ(std::vector<std::string>({"two", "four"}), selected.column<2>());
+    }
+
+    {
+        const std::list<int> l{5, 1, 7};
+        EXPECT_EQ(std::vector<size_t>({0, 2}), sca::where([](int i) { return i > 4; }, l));
+    }
+
+    soa.resize(2);
+    EXPECT_EQ(2, soa.column<2>().size());
+    soa.clear();
+    EXPECT_TRUE(soa.empty());
+}
+
+namespace lesson_7_ns {
+
+struct tick {
+    long time;
+    double price;
+    int volume;
+};
+
+}
+
+TEST(lesson_7, transpose) {
+    using lesson_7_ns::tick;
+
+    for(size_t len : {0, 1, 3, 2000}) {
+        std::vector<tick> ticks(len);
+
+        for(size_t i = 0; i < len; ++i) {
+            ticks[i] = tick{ (long)i * 1000, (double)i * 0.25, (int)(i % 7) };
+        }
+
+        auto cols = sca::to_columns(ticks, &tick::time, &tick::volume, &tick::price);
+        auto is_same = std::is_same<sca::soa_vector<long, int, double>,decltype(cols)>::value;
+        EXPECT_TRUE(is_same);
+        ASSERT_EQ(len, cols.size());
+
+        for(size_t i = 0; i < len; ++i) {
+            EXPECT_EQ(ticks[i].time, cols.column<0>()[i]);
+            EXPECT_EQ(ticks[i].volume, cols.column<1>()[i]);
+            EXPECT_EQ(ticks[i].price, cols.column<2>()[i]);
+        }
+
+        auto rows = sca::to_rows(cols, &tick::time, &tick::volume, &tick::price);
+        is_same = std::is_same<std::vector<tick>,decltype(rows)>::value;
+        EXPECT_TRUE(is_same);
+        ASSERT_EQ(len, rows.size());
+
+        for(size_t i = 0; i < len; ++i) {
+            EXPECT_EQ(ticks[i].time, rows[i].time);
+            EXPECT_EQ(ticks[i].volume, rows[i].volume);
+            EXPECT_EQ(ticks[i].price, rows[i].price);
+        }
+    }
+
+    {
+        // a subset of members, from a non-contiguous container
+        const std::list<tick> l{ tick{1, 2.0, 3}, tick{4, 5.0, 6} };
+        auto cols = sca::to_columns(sca::values(l), &tick::price);
+        EXPECT_EQ(std::vector<double>({2.0, 5.0}), cols.column<0>());
+
+        auto rows = sca::to_rows(cols, &tick::price);
+        EXPECT_EQ(0, rows[1].time);
+        EXPECT_EQ(5.0, rows[1].price);
+    }
+}
+
+TEST(lesson_7, radix_sort) {
+    {
+        // radix keys preserve order
+        EXPECT_LT(sca::detail::to_radix_key(-5), sca::detail::to_radix_key(3));
+        EXPECT_LT(sca::detail::to_radix_key(-5.5), sca::detail::to_radix_key(-1.0));
+        EXPECT_LT(sca::detail::to_radix_key(-1.0f), sca::detail::to_radix_key(0.5f));
+        EXPECT_EQ(-7.25, sca::detail::from_radix_key<double>(sca::detail::to_radix_key(-7.25)));
+        EXPECT_EQ(-7, sca::detail::from_radix_key<long>(sca::detail::to_radix_key(-7L)));
+    }
+
+    for(size_t len : {0, 1, 100, 5000}) {
+        std::vector<int64_t> v(len);
+        std::vector<double> dv(len);
+        std::vector<uint8_t> bv(len);
+
+        for(size_t i = 0; i < len; ++i) {
+            v[i] = (int64_t)((i * 2654435761u) % 100000) - 50000;
+            dv[i] = (double)v[i] / 7.0;
+            bv[i] = (uint8_t)v[i];
+        }
+
+        auto expect = v;
+        std::sort(expect.begin(), expect.end());
+        EXPECT_EQ(expect, sca::radix_sort(v));
+        EXPECT_EQ(expect, sca::sort(v, std::less<int64_t>()));
+        EXPECT_EQ(expect, sca::sort(v, std::less<>()));
+
+        std::reverse(expect.begin(), expect.end());
+        EXPECT_EQ(expect, sca::sort(v, std::greater<>()));
+
+        auto dexpect = dv;
+        std::sort(dexpect.begin(), dexpect.end());
+        EXPECT_EQ(dexpect, sca::radix_sort(dv));
+        EXPECT_EQ(dexpect, sca::sort(dv, std::less<double>()));
+
+        auto bexpect = bv;
+        std::sort(bexpect.begin(), bexpect.end());
+        EXPECT_EQ(bexpect, sca::radix_sort(bv));
+    }
+
+    {
+        // sorting by key is stable
+        const std::vector<std::string> v{"ccc", "a", "bb", "dd", "e", "fff"};
+        auto out = sca::radix_sort(v, [](const std::string& s) { return s.size(); });
+        EXPECT_EQ(std::vector<std::string>({"a", "e", "bb", "dd", "ccc", "fff"}), out);
+
+        const std::list<double> l{2.5, -1.0, 0.0, -3.5};
+        EXPECT_EQ(std::vector<double>({-3.5, -1.0, 0.0, 2.5}), sca::radix_sort(l));
+    }
+}
+
+TEST(lesson_7, sort_by) {
+    {
+        // keys are computed exactly once per element
+        const std::vector<std::string> v{"ccc", "a", "bb", "dd", "e", "fff"};
+        size_t calls = 0;
+        auto out = sca::sort_by(v, [&](const std::string& s) { ++calls; return s; });
+        EXPECT_EQ(v.size(), calls);
+        EXPECT_EQ(std::vector<std::string>({"a", "bb", "ccc", "dd", "e", "fff"}), out);
+
+        // stable for equal keys 
+        auto by_len = sca::sort_by(v, [](const std::string& s) { return s.size(); }, std::greater<>());
+        EXPECT_EQ(std::vector<std::string>({"ccc", "fff", "bb", "dd", "a", "e"}), by_len);
+
+        auto by_str_len = sca::sort_by(v, [](const std::string& s) { return std::to_string(s.size()); });
+        EXPECT_EQ(std::vector<std::string>({"a", "e", "bb", "dd", "ccc", "fff"}), by_str_len);
+    }
+
+    {
+        // rvalue elements are moved into place
+        std::list<std::unique_ptr<int>> l;
+        for(int i : {3, 1, 2}) {
+            l.push_back(std::unique_ptr<int>(new int(i)));
+        }
+
+        auto out = sca::sort_by(std::move(l), [](const std::unique_ptr<int>& p) { return -*p; });
+        EXPECT_EQ(3, *out[0]);
+        EXPECT_EQ(2, *out[1]);
+        EXPECT_EQ(1, *out[2]);
+    }
+}
+
+TEST(lesson_7, top_k) {
+    std::vector<int> v(1000);
+    for(size_t i = 0; i < v.size(); ++i) {
+        v[i] = (int)((i * 7919) % 1000);
+    }
+
+    auto sorted = sca::sort(v, std::less<int>());
+
+    {
+        auto out = sca::top_k(v, 10);
+        EXPECT_EQ(std::vector<int>(sorted.begin(), sorted.begin() + 10), out);
+
+        auto rout = sca::top_k(v, 3, std::greater<int>());
+        EXPECT_EQ(std::vector<int>({999, 998, 997}), rout);
+
+        EXPECT_EQ(0, sca::top_k(v, 0).size());
+        EXPECT_EQ(sorted, sca::top_k(v, 5000));
+
+        std::list<std::string> l{"d", "b", "e", "a", "c"};
+        EXPECT_EQ(std::vector<std::string>({"a", "b"}), sca::top_k(std::move(l), 2));
+    }
+
+    {
+        auto out = sca::partial_sort(v, 10);
+        EXPECT_EQ(v.size(), out.size());
+        EXPECT_TRUE(std::equal(sorted.begin(), sorted.begin() + 10, out.begin()));
+        EXPECT_EQ(sorted, sca::sort(out, std::less<int>()));
+        EXPECT_EQ(sorted, sca::partial_sort(v, 5000));
+    }
+
+    {
+        auto out = sca::nth(v, 500);
+        EXPECT_EQ(sorted[500], out[500]);
+        EXPECT_TRUE(std::all_of(out.begin(), out.begin() + 500, [&](int i) { return i <= out[500]; }));
+        EXPECT_TRUE(std::all_of(out.begin() + 500, out.end(), [&](int i) { return i >= out[500]; }));
+        EXPECT_EQ(v, sca::nth(v, 5000));
+    }
+}
+
+TEST(lesson_7, stable_sort) {
+    typedef std::pair<int, size_t> P;
+    auto first_less = [](const P& a, const P& b) { return a.first < b.first; };
+
+    for(size_t len : {0, 1, 2, 31, 100, 1000, 20000}) {
+        // random keys with many duplicates
+        std::vector<P> rnd(len);
+        // concatenated sorted shards
+        std::vector<P> shards(len);
+        // ascending and descending runs
+        std::vector<P> saw(len);
+
+        for(size_t i = 0; i < len; ++i) {
+            rnd[i] = P((int)((i * 2654435761u) % 97), i);
+            shards[i] = P((int)(i % 1234), i);
+            saw[i] = P((i / 300) % 2 ? (int)(300 - i % 300) : (int)(i % 300), i);
+        }
+
+        for(auto v : {rnd, shards, saw}) {
+            auto expect = v;
+            std::stable_sort(expect.begin(), expect.end(), first_less);
+            EXPECT_EQ(expect, sca::stable_sort(v, first_less));
+        }
+    }
+
+    {
+        // sorted input costs n - 1 comparisons
+        std::vector<int> v(10000);
+        std::iota(v.begin(), v.end(), 0);
+        size_t cmps = 0;
+        auto out = sca::stable_sort(v, [&](int a, int b) { ++cmps; return a < b; });
+        EXPECT_EQ(v, out);
+        EXPECT_EQ(v.size() - 1, cmps);
+
+        // so does strictly descending input
+        std::reverse(v.begin(), v.end());
+        cmps = 0;
+        out = sca::stable_sort(v, [&](int a, int b) { ++cmps; return a < b; });
+        EXPECT_EQ(sca::sort(v, std::less<int>()), out);
+        EXPECT_EQ(v.size() - 1, cmps);
+    }
+
+    {
+        std::list<std::unique_ptr<int>> l;
+        for(int i : {3, 1, 2}) {
+            l.push_back(std::unique_ptr<int>(new int(i)));
+        }
+
+        auto out = sca::stable_sort(std::move(l), 
+            [](const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) { return *a < *b; });
+        EXPECT_EQ(1, *out[0]);
+        EXPECT_EQ(2, *out[1]);
+        EXPECT_EQ(3, *out[2]);
+    }
+}
+
+TEST(lesson_7, merge) {
+    {
+        std::vector<int> v1{1, 4, 7, 10};
+        std::list<int> l2{2, 5, 8};
+        std::vector<int> v3{0, 3, 6, 9, 11, 12};
+        std::vector<int> empty;
+
+        EXPECT_EQ(std::vector<int>({1, 2, 4, 5, 7, 8, 10}), sca::merge(std::less<int>(), v1, l2));
+        EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}), 
+                  sca::merge(std::less<int>(), v1, l2, v3, empty));
+        EXPECT_EQ(v1, sca::merge(std::less<int>(), empty, v1, empty));
+        EXPECT_EQ(0, sca::merge(std::less<int>(), empty, empty).size());
+    }
+
+    {
+        // equal elements are output in argument order 
+        typedef std::pair<int, int> P;
+        auto first_less = [](const P& a, const P& b) { return a.first < b.first; };
+        std::vector<P> a{{1, 0}, {2, 0}, {2, 0}, {5, 0}};
+        std::vector<P> b{{2, 1}, {3, 1}, {5, 1}};
+        std::vector<P> c{{1, 2}, {2, 2}, {6, 2}};
+        std::vector<P> expect{{1, 0}, {1, 2}, {2, 0}, {2, 0}, {2, 1}, {2, 2}, {3, 1}, {5, 0}, {5, 1}, {6, 2}};
+        EXPECT_EQ(expect, sca::merge(first_less, a, b, c));
+    }
+
+    {
+        // many shards
+        std::vector<std::vector<int>> shards(5);
+        for(int i = 0; i < 1000; ++i) {
+            shards[(i * 7) % 5].push_back(i);
+        }
+
+        std::vector<int> expect(1000);
+        std::iota(expect.begin(), expect.end(), 0);
+        EXPECT_EQ(expect, sca::merge(std::less<int>(), shards[0], shards[1], shards[2], shards[3], shards[4]));
+
+        auto rout = sca::merge(std::greater<int>(), 
+                               sca::reverse(shards[0]), sca::reverse(shards[1]), sca::reverse(shards[2]));
+        EXPECT_EQ(sca::sort(sca::group(shards[0], shards[1], shards[2]), std::greater<int>()), rout);
+    }
+
+    {
+        // rvalue inputs are moved
+        std::vector<std::unique_ptr<int>> a;
+        std::list<std::unique_ptr<int>> b;
+        a.push_back(std::unique_ptr<int>(new int(1)));
+        a.push_back(std::unique_ptr<int>(new int(3)));
+        b.push_back(std::unique_ptr<int>(new int(2)));
+        auto ptr_less = [](const std::unique_ptr<int>& x, const std::unique_ptr<int>& y) { return *x < *y; };
+        auto out = sca::merge(ptr_less, std::move(a), std::move(b));
+        ASSERT_EQ(3, out.size());
+        EXPECT_EQ(1, *out[0]);
+        EXPECT_EQ(2, *out[1]);
+        EXPECT_EQ(3, *out[2]);
+    }
+}
+
+TEST(lesson_7, network_sort) {
+    {
+        EXPECT_EQ(0, sca::detail::network<1>::size);
+        EXPECT_EQ(1, sca::detail::network<2>::size);
+        EXPECT_EQ(5, sca::detail::network<4>::size);
+        EXPECT_EQ(19, sca::detail::network<8>::size);
+    }
+
+    {
+        std::array<int, 5> a{{4, -1, 3, 3, 0}};
+        std::array<int, 5> expect{{-1, 0, 3, 3, 4}};
+        EXPECT_EQ(expect, sca::network_sort(a));
+
+        std::array<std::string, 4> s{{"d", "b", "c", "a"}};
+        std::array<std::string, 4> sexpect{{"d", "c", "b", "a"}};
+        EXPECT_EQ(sexpect, sca::network_sort(s, std::greater<std::string>()));
+
+        std::array<double, 0> empty{};
+        EXPECT_EQ(empty, sca::network_sort(empty));
+    }
+
+    {
+        // proxy containers have no data() and are sorted without the network
+        const std::vector<bool> v{true, false, true};
+        EXPECT_EQ(std::vector<bool>({false, true, true}), sca::sort(v, std::less<bool>()));
+    }
+
+    // every size up to the threshold, through sort()
+    for(size_t len = 0; len <= sca::detail::network_sort_threshold + 1; ++len) {
+        for(size_t seed = 1; seed < 20; ++seed) {
+            std::vector<double> v(len);
+            for(size_t i = 0; i < len; ++i) {
+                v[i] = (double)((i * seed * 2654435761u) % 13) - 6.5;
+            }
+
+            auto expect = v;
+            std::sort(expect.begin(), expect.end());
+            EXPECT_EQ(expect, sca::sort(v, std::less<double>()));
+            EXPECT_EQ(expect, sca::sort(v, [](double a, double b) { return a < b; }));
+
+            std::reverse(expect.begin(), expect.end());
+            EXPECT_EQ(expect, sca::sort(v, std::greater<>()));
+        }
+    }
+}
+
+TEST(lesson_7, string_sort) {
+    {
+        EXPECT_LT(sca::detail::string_key("abc", 0), sca::detail::string_key("abd", 0));
+        EXPECT_LT(sca::detail::string_key("ab", 0), sca::detail::string_key("abc", 0));
+        EXPECT_LT(sca::detail::string_key("\x7f", 0), sca::detail::string_key("\x80", 0));
+        EXPECT_EQ(sca::detail::string_key("12345678abc", 8), sca::detail::string_key("abc", 0));
+        EXPECT_EQ(0, sca::detail::string_key("abc", 8));
+    }
+
+    for(size_t len : {0, 1, 10, 100, 3000}) {
+        std::vector<std::string> v(len);
+
+        for(size_t i = 0; i < len; ++i) {
+            const size_t h = (i * 2654435761u) % 1000;
+            // long shared prefixes, duplicates, prefixes of other strings, 
+            // embedded '\0's and bytes above 0x7f
+            v[i] = "https://example.com/users/" + std::to_string(h % 300);
+            v[i].append(h % 7, h % 3 ? '/' : '\0');
+            if(h % 11 == 0) {
+                v[i] = std::string(h % 9, '\xff');
+            }
+        }
+
+        auto expect = v;
+        std::sort(expect.begin(), expect.end());
+        EXPECT_EQ(expect, sca::string_sort(v));
+        EXPECT_EQ(expect, sca::sort(v, std::less<std::string>()));
+        EXPECT_EQ(expect, sca::sort(v, std::less<>()));
+
+        std::reverse(expect.begin(), expect.end());
+        EXPECT_EQ(expect, sca::sort(v, std::greater<>()));
+    }
+
+    {
+        std::list<std::string> l{"b", "", "a", "ab"};
+        EXPECT_EQ(std::vector<std::string>({"", "a", "ab", "b"}), sca::string_sort(std::move(l)));
+    }
+}
+
+TEST(lesson_7, group_by) {
+    {
+        const std::vector<std::string> v{"ccc", "a", "bb", "dd", "e", "fff", "gggg"};
+        size_t calls = 0;
+        auto by_len = sca::group_by([&](const std::string& s) { ++calls; return s.size(); }, v);
+        EXPECT_EQ(v.size(), calls);
+        EXPECT_EQ(4, by_len.size());
+        EXPECT_EQ(std::vector<size_t>({3, 1, 2, 4}), by_len.keys());
+        EXPECT_EQ(std::vector<size_t>({0, 2, 4, 6, 7}), by_len.offsets());
+        EXPECT_EQ(std::vector<std::string>({"ccc", "fff", "a", "e", "bb", "dd", "gggg"}), by_len.values());
+
+        auto g = by_len.group(2);
+        EXPECT_EQ(std::vector<std::string>({"bb", "dd"}), std::vector<std::string>(g.begin(), g.end()));
+        EXPECT_EQ(2, by_len.key(2));
+    }
+
+    {
+        std::vector<int> empty;
+        auto g = sca::group_by([](int i) { return i; }, empty);
+        EXPECT_TRUE(g.empty());
+        EXPECT_EQ(std::vector<size_t>({0}), g.offsets());
+    }
+
+    {
+        // many keys, through table growth 
+        std::vector<int> v(10000);
+        for(size_t i = 0; i < v.size(); ++i) {
+            v[i] = (int)((i * 7919) % 10000);
+        }
+
+        auto g = sca::group_by([](int i) { return i % 1024; }, v);
+        EXPECT_EQ(1024, g.size());
+        for(size_t i = 0; i < g.size(); ++i) {
+            for(int e : g.group(i)) {
+                EXPECT_EQ(g.key(i), e % 1024);
+            }
+        }
+        EXPECT_EQ(sca::sort(v, std::less<int>()), sca::sort(g.values(), std::less<int>()));
+    }
+
+    {
+        // rvalue elements are moved, single pass inputs are supported
+        std::list<std::unique_ptr<int>> l;
+        for(int i : {1, 2, 3, 4}) {
+            l.push_back(std::unique_ptr<int>(new int(i)));
+        }
+
+        auto g = sca::group_by([](const std::unique_ptr<int>& p) { return *p % 2 == 0; }, std::move(l));
+        ASSERT_EQ(2, g.size());
+        EXPECT_EQ(3, *g.values()[1]);
+
+        std::istringstream ss("1 2 3 4 5");
+        auto parity = sca::group_by([](int i) { return i % 2; }, 
+            sca::range(std::istream_iterator<int>(ss), std::istream_iterator<int>()));
+        EXPECT_EQ(std::vector<int>({1, 3, 5, 2, 4}), parity.values());
+    }
+}
+
+TEST(lesson_7, flat_map) {
+    {
+        sca::flat_map<std::string, int> m;
+        EXPECT_TRUE(m.empty());
+        EXPECT_EQ(m.end(), m.find("missing"));
+
+        ++m["a"];
+        ++m["b"];
+        ++m["a"];
+        EXPECT_EQ(2, m.size());
+        EXPECT_EQ(2, m["a"]);
+        EXPECT_EQ(1, m.find("b")->second);
+        EXPECT_FALSE(m.try_emplace("a", 10).second);
+        EXPECT_TRUE(m.insert(std::make_pair(std::string("c"), 3)).second);
+        EXPECT_EQ(1, m.count("c"));
+        EXPECT_EQ(1, m.erase("c"));
+        EXPECT_EQ(0, m.erase("c"));
+        EXPECT_FALSE(m.contains("c"));
+
+        auto copy = m;
+        m.clear();
+        EXPECT_TRUE(m.empty());
+        EXPECT_EQ(2, copy.size());
+        EXPECT_EQ(2, copy["a"]);
+
+        auto moved = std::move(copy);
+        EXPECT_EQ(1, moved["b"]);
+
+        // keys are const, as in std::unordered_map
+        EXPECT_TRUE((std::is_same<std::pair<const std::string, int>, decltype(m)::value_type>::value));
+        EXPECT_TRUE((std::is_same<const std::string&, decltype((m.begin()->first))>::value));
+    }
+
+    {
+        // growth, erasure and reuse of deleted slots against a reference map
+        sca::flat_map<int, int> m;
+        std::unordered_map<int, int> expect;
+
+        for(int i = 0; i < 20000; ++i) {
+            const int k = (int)((i * 2654435761u) % 5000) * 1024;
+
+            if(i % 3 == 0) {
+                EXPECT_EQ(expect.erase(k), m.erase(k));
+            } else {
+                m[k] += i;
+                expect[k] += i;
+            }
+        }
+
+        EXPECT_EQ(expect.size(), m.size());
+        EXPECT_EQ(expect.size(), (size_t)std::distance(m.begin(), m.end()));
+
+        for(const auto& kv : m) {
+            EXPECT_EQ(expect[kv.first], kv.second);
+        }
+    }
+
+    {
+        sca::flat_set<std::string> s;
+        EXPECT_TRUE(s.insert("x").second);
+        EXPECT_FALSE(s.insert(std::string("x")).second);
+        s.insert("y");
+        EXPECT_EQ(2, s.size());
+        EXPECT_TRUE(s.contains("y"));
+        EXPECT_EQ(1, s.erase("x"));
+        EXPECT_EQ(std::vector<std::string>({"y"}), std::vector<std::string>(s.begin(), s.end()));
+
+        sca::flat_set<std::unique_ptr<int>> ptrs;
+        ptrs.insert(std::unique_ptr<int>(new int(1)));
+        ptrs.reserve(1000);
+        EXPECT_EQ(1, **ptrs.begin());
+    }
+}
+
+TEST(lesson_7, flat_map_lookup) {
+    const size_t len = 200000;
+    std::vector<uint64_t> keys(len);
+
+    for(size_t i = 0; i < len; ++i) {
+        keys[i] = (i * 0x9E3779B97F4A7C15ull) >> 20;
+    }
+
+    sca::flat_map<uint64_t, size_t> m;
+    std::unordered_map<uint64_t, size_t> expect;
+
+    for(size_t i = 0; i < len; ++i) {
+        m[keys[i]] = i;
+        expect[keys[i]] = i;
+    }
+
+    EXPECT_EQ(expect.size(), m.size());
+
+    for(size_t i = 0; i < len; ++i) {
+        EXPECT_EQ(expect.count(keys[i] + 1), m.count(keys[i] + 1));
+        auto it = m.find(keys[i]);
+        ASSERT_NE(m.end(), it);
+        EXPECT_EQ(keys[i], it->first);
+        EXPECT_EQ(expect[keys[i]], it->second);
+    }
+}
+
+TEST(lesson_7, hash_join) {
+    struct event { int user; int amount; };
+    struct user { int id; std::string name; };
+
+    const std::vector<event> events{{1, 10}, {2, 20}, {1, 30}, {3, 40}, {4, 50}};
+    const std::list<user> users{{1, "ann"}, {2, "bob"}, {3, "cid"}, {5, "dan"}};
+    auto event_user = [](const event& e) { return e.user; };
+    auto user_id = [](const user& u) { return u.id; };
+    auto label = [](const event& e, const user& u) { return u.name + ":" + std::to_string(e.amount); };
+
+    {
+        // users is smaller and is hashed, results follow the order of events
+        auto out = sca::hash_join(event_user, events, user_id, users, label);
+        EXPECT_EQ(std::vector<std::string>({"ann:10", "bob:20", "ann:30", "cid:40"}), out);
+
+        auto pout = sca::partitioned_hash_join(event_user, events, user_id, users, label);
+        EXPECT_EQ(sca::sort(out, std::less<std::string>()), sca::sort(pout, std::less<std::string>()));
+    }
+
+    {
+        // duplicate keys on both sides produce every pair 
+        std::vector<int> a{1, 1, 2};
+        std::vector<int> b{1, 2, 2, 1, 3};
+        auto id = [](int i) { return i; };
+        auto pair = [](int x, int y) { return std::make_pair(x, y); };
+        auto out = sca::hash_join(id, a, id, b, pair);
+        EXPECT_EQ(6, out.size());
+        EXPECT_TRUE(std::all_of(out.begin(), out.end(), [](const std::pair<int, int>& p) { return p.first == p.second; }));
+
+        std::vector<int> none;
+        EXPECT_EQ(0, sca::hash_join(id, a, id, none, pair).size());
+        EXPECT_EQ(0, sca::partitioned_hash_join(id, none, id, b, pair).size());
+    }
+
+    {
+        // the smaller side's elements are proxies, not lvalues
+        const std::vector<bool> flags{true, false};
+        const std::vector<int> values{0, 1, 1, 2};
+        auto flag_id = [](bool f) { return (int)f; };
+        auto id = [](int i) { return i; };
+        auto pair = [](bool f, int i) { return std::make_pair(f, i); };
+        const std::vector<std::pair<bool, int>> expect{{false, 0}, {true, 1}, {true, 1}};
+        EXPECT_EQ(expect, sca::hash_join(flag_id, flags, id, values, pair));
+        EXPECT_EQ(expect, sca::sort(sca::partitioned_hash_join(flag_id, flags, id, values, pair), std::less<std::pair<bool, int>>()));
+    }
+
+    {
+        // inputs large enough to be partitioned 
+        std::vector<int> a(20000);
+        std::vector<int> b(30000);
+        for(size_t i = 0; i < a.size(); ++i) {
+            a[i] = (int)i * 3;
+        }
+        for(size_t i = 0; i < b.size(); ++i) {
+            b[i] = (int)i * 2;
+        }
+
+        auto id = [](int i) { return i; };
+        auto first = [](int x, int) { return x; };
+        auto out = sca::hash_join(id, a, id, b, first);
+        auto pout = sca::partitioned_hash_join(id, a, id, b, first);
+        // multiples of 6 below 60000
+        EXPECT_EQ(10000, out.size());
+        EXPECT_EQ(sca::sort(out, std::less<int>()), sca::sort(pout, std::less<int>()));
+    }
+}
+
+TEST(lesson_7, distinct_unique) {
+    {
+        const std::vector<std::string> v{"b", "a", "b", "c", "a", "d", "b"};
+        EXPECT_EQ(std::vector<std::string>({"b", "a", "c", "d"}), sca::distinct(v));
+        EXPECT_EQ(0, sca::distinct(std::vector<int>()).size());
+
+        std::list<std::string> l(v.begin(), v.end());
+        EXPECT_EQ(std::vector<std::string>({"b", "a", "c", "d"}), sca::distinct(std::move(l)));
+
+        std::istringstream ss("3 1 3 2 1");
+        EXPECT_EQ(std::vector<int>({3, 1, 2}), 
+                  sca::distinct(sca::range(std::istream_iterator<int>(ss), std::istream_iterator<int>())));
+    }
+
+    {
+        std::vector<int> v(10000);
+        for(size_t i = 0; i < v.size(); ++i) {
+            v[i] = (int)((i * 7919) % 1000);
+        }
+
+        auto d = sca::distinct(v);
+        EXPECT_EQ(1000, d.size());
+        EXPECT_EQ(std::vector<int>(v.begin(), v.begin() + 1000), d);
+        EXPECT_EQ(sca::sort(d, std::less<int>()), sca::unique(sca::sort(v, std::less<int>())));
+    }
+
+    {
+        EXPECT_EQ(std::vector<int>({1, 2, 3}), sca::unique(std::vector<int>{1, 1, 2, 3, 3, 3}));
+        EXPECT_EQ(0, sca::unique(std::list<int>()).size());
+
+        // with an equality comparison 
+        const std::vector<std::string> words{"apple", "avocado", "banana", "blueberry", "cherry"};
+        auto first_letter = [](const std::string& a, const std::string& b) { return a[0] == b[0]; };
+        EXPECT_EQ(std::vector<std::string>({"apple", "banana", "cherry"}), sca::unique(words, first_letter));
+    }
+}
+
+TEST(lesson_7, parallel_distinct_unique) {
+    {
+        // small and non contiguous containers run as the sequential algorithms
+        const std::vector<std::string> v{"b", "a", "b", "c", "a", "d", "b"};
+        EXPECT_EQ(sca::distinct(v), sca::distinct(sca::parallel, v));
+        EXPECT_EQ(std::vector<int>({1, 2, 3}), sca::unique(sca::parallel, std::list<int>{1, 1, 2, 3, 3}));
+
+        std::istringstream ss("3 1 3 2 1");
+        EXPECT_EQ(std::vector<int>({3, 1, 2}), 
+                  sca::distinct(sca::parallel, sca::range(std::istream_iterator<int>(ss), std::istream_iterator<int>())));
+    }
+
+    {
+        std::vector<int> v(300000);
+        for(size_t i = 0; i < v.size(); ++i) {
+            v[i] = (int)((i * 7919) % 5003);
+        }
+
+        EXPECT_EQ(sca::distinct(v), sca::distinct(sca::parallel, v));
+
+        auto sorted = sca::sort(v, std::less<int>());
+        EXPECT_EQ(sca::unique(sorted), sca::unique(sca::parallel, sorted));
+
+        // force several workers, whatever the count of hardware threads
+        for(size_t workers : {2, 3, 7}) {
+            std::vector<int> d;
+            sca::detail::parallel_distinct(std::true_type(), d, v, workers);
+            EXPECT_EQ(sca::distinct(v), d);
+
+            std::vector<int> u;
+            std::equal_to<> eq;
+            sca::detail::parallel_unique(std::true_type(), u, eq, sorted, workers);
+            EXPECT_EQ(sca::unique(sorted), u);
+        }
+    }
+
+    {
+        // runs which span worker ranges, and elements moved from an rvalue
+        std::vector<std::string> v;
+        for(size_t i = 0; i < 1000; ++i) {
+            v.insert(v.end(), i % 13 + 1, std::to_string(i));
+        }
+
+        const auto expect = sca::unique(v);
+        std::vector<std::string> u;
+        std::equal_to<> eq;
+        sca::detail::parallel_unique(std::true_type(), u, eq, std::move(v), 5);
+        EXPECT_EQ(expect, u);
+    }
+}
+
+TEST(lesson_7, count_by) {
+    {
+        const std::vector<std::string> words{"a", "bb", "a", "ccc", "bb", "a"};
+        auto counts = sca::count_by([](const std::string& s) { return s; }, words);
+        EXPECT_EQ(3, counts.size());
+        EXPECT_EQ(3, counts["a"]);
+        EXPECT_EQ(2, counts["bb"]);
+        EXPECT_EQ(1, counts["ccc"]);
+
+        // dense integer keys, including negatives 
+        auto lens = sca::count_by([](const std::string& s) { return 1 - (int)s.size(); }, words);
+        EXPECT_EQ(3, lens.size());
+        EXPECT_EQ(3, lens[0]);
+        EXPECT_EQ(2, lens[-1]);
+        EXPECT_EQ(1, lens[-2]);
+
+        EXPECT_TRUE(sca::count_by([](int i) { return i; }, std::vector<int>()).empty());
+    }
+
+    {
+        // sparse integer keys are hashed, and agree with dense counting
+        std::vector<int64_t> v(10000);
+        for(size_t i = 0; i < v.size(); ++i) {
+            v[i] = (int64_t)((i * 7919) % 100);
+        }
+
+        auto dense = sca::count_by([](int64_t i) { return i; }, v);
+        auto sparse = sca::count_by([](int64_t i) { return i * 1000000007ll; }, v);
+        auto hashed = sca::count_by([](int64_t i) { return std::to_string(i); }, v);
+        EXPECT_EQ(100, dense.size());
+        EXPECT_EQ(100, sparse.size());
+
+        for(int64_t k = 0; k < 100; ++k) {
+            EXPECT_EQ(100, dense[k]);
+            EXPECT_EQ(100, sparse[k * 1000000007ll]);
+            EXPECT_EQ(100, hashed[std::to_string(k)]);
+        }
+
+        std::vector<uint8_t> bytes{0, 255, 255, 7};
+        auto byte_counts = sca::count_by([](uint8_t b) { return b; }, bytes);
+        EXPECT_EQ(2, byte_counts[255]);
+    }
+}
+
+TEST(lesson_7, histogram) {
+    const std::vector<double> v{0.0, 0.5, 1.0, 2.5, 3.9, 4.0};
+    EXPECT_EQ(std::vector<size_t>({2, 1, 1, 2}), sca::histogram(v, 4));
+    EXPECT_EQ(std::vector<size_t>({3, 1}), sca::histogram(v, 2, 0.0, 3.0));
+    EXPECT_EQ(std::vector<size_t>({0, 0}), sca::histogram(std::vector<int>(), 2));
+    EXPECT_EQ(std::vector<size_t>({3}), sca::histogram(std::list<int>{5, 5, 5}, 1));
+
+    std::vector<int> ints(1000);
+    std::iota(ints.begin(), ints.end(), 0);
+    auto h = sca::histogram(ints, 10, 0, 1000);
+    EXPECT_TRUE(std::all_of(h.begin(), h.end(), [](size_t n) { return n == 100; }));
+}
+
+namespace lesson_7_ns {
+
+// a state which counts how many times it was copied or moved
+struct counted_state {
+    counted_state() = default;
+    counted_state(const counted_state& o) : sum(o.sum), transfers(o.transfers + 1) { }
+    counted_state(counted_state&& o) : sum(o.sum), transfers(o.transfers + 1) { }
+    counted_state& operator=(const counted_state& o) { sum = o.sum; transfers = o.transfers + 1; return *this; }
+    counted_state& operator=(counted_state&& o) { sum = o.sum; transfers = o.transfers + 1; return *this; }
+
+    int sum = 0;
+    size_t transfers = 0;
+};
+
+}
+
+TEST(lesson_7, fold_into) {
+    {
+        const std::vector<std::string> fields{"a", "b", "c"};
+        auto csv = sca::fold_into([](std::string& s, const std::string& field) { 
+            s += field;
+            s += ',';
+        }, std::string(), fields);
+        EXPECT_EQ("a,b,c,", csv);
+    }
+
+    {
+        // multiple containers, non random access
+        const std::list<std::string> keys{"x", "y", "x"};
+        const std::vector<int> values{1, 2, 3};
+        auto m = sca::fold_into([](std::map<std::string, int>& m, const std::string& k, int v) { 
+            m[k] += v; 
+        }, std::map<std::string, int>(), keys, values);
+        EXPECT_EQ(2, m.size());
+        EXPECT_EQ(4, m["x"]);
+        EXPECT_EQ(2, m["y"]);
+    }
+
+    {
+        // the state is never moved per element, unlike fold()
+        std::vector<int> v(100, 1);
+        auto into = sca::fold_into([](lesson_7_ns::counted_state& s, int i) { s.sum += i; }, 
+                                   lesson_7_ns::counted_state(), v);
+        EXPECT_EQ(100, into.sum);
+        EXPECT_GE(2u, into.transfers);
+
+        auto folded = sca::fold([](lesson_7_ns::counted_state s, int i) { s.sum += i; return s; }, 
+                                lesson_7_ns::counted_state(), v);
+        EXPECT_EQ(100, folded.sum);
+        EXPECT_LT(100u, folded.transfers);
+
+        // an lvalue state is copied, not modified
+        lesson_7_ns::counted_state init;
+        init.sum = 5;
+        EXPECT_EQ(105, sca::fold_into([](lesson_7_ns::counted_state& s, int i) { s.sum += i; }, init, v).sum);
+        EXPECT_EQ(5, init.sum);
+    }
+}
+
+namespace lesson_7_ns {
+
+// a user defined accumulator of the sum of squared elements
+struct sum_of_squares {
+    template <typename T> 
+    T init() const { return T(); }
+
+    template <typename S, typename T> 
+    void add(S& s, const T& t) const { s += t * t; }
+
+    template <typename S> 
+    S result(const S& s, size_t) const { return s; }
+};
+
+}
+
+TEST(lesson_7, aggregate) {
+    {
+        // vectorized built-in accumulators, including a scalar tail
+        std::vector<int> v;
+        for(int i = 0; i < 1003; ++i) {
+            v.push_back((i * 37) % 1001 - 500);
+        }
+
+        auto r = sca::aggregate(v, sca::agg::sum, sca::agg::min, sca::agg::max, sca::agg::count, sca::agg::mean);
+        EXPECT_EQ(sca::sum(v), std::get<0>(r));
+        EXPECT_EQ(sca::min(v), std::get<1>(r));
+        EXPECT_EQ(sca::max(v), std::get<2>(r));
+        EXPECT_EQ(v.size(), std::get<3>(r));
+        EXPECT_DOUBLE_EQ(double(sca::sum(v)) / v.size(), std::get<4>(r));
+
+        // a single accumulator, repeated accumulators
+        EXPECT_EQ(-500, std::get<0>(sca::aggregate(v, sca::agg::min)));
+        auto r2 = sca::aggregate(v, sca::agg::max, sca::agg::max);
+        EXPECT_EQ(std::get<0>(r2), std::get<1>(r2));
+    }
+
+    {
+        // floating point sums are ordered unless reassociation is allowed
+        std::vector<double> v;
+        for(int i = 0; i < 1000; ++i) {
+            v.push_back(0.1 * i);
+        }
+
+        auto r = sca::aggregate(v, sca::agg::sum, sca::agg::min, sca::agg::max);
+        EXPECT_EQ(sca::fold([](double acc, double d) { return acc + d; }, 0.0, v), std::get<0>(r));
+        EXPECT_EQ(0.0, std::get<1>(r));
+        EXPECT_EQ(99.9, std::get<2>(r));
+
+        auto r2 = sca::aggregate(sca::reassociate, v, sca::agg::mean, sca::agg::count);
+        EXPECT_NEAR(49.95, std::get<0>(r2), 1e-9);
+        EXPECT_EQ(1000, std::get<1>(r2));
+    }
+
+    {
+        // sums and means of narrow elements are accumulated in wider types
+        const std::vector<uint8_t> bytes(1000, 200);
+        auto r = sca::aggregate(bytes, sca::agg::sum, sca::agg::mean, sca::agg::max);
+        EXPECT_TRUE((std::is_same<uint64_t, std::tuple_element_t<0, decltype(r)>>::value));
+        EXPECT_EQ(200000u, std::get<0>(r));
+        EXPECT_EQ(200.0, std::get<1>(r));
+        EXPECT_EQ(200, std::get<2>(r));
+        EXPECT_EQ(SCA_SIMD, (sca::detail::is_simd_aggregate_t<const std::vector<uint8_t>&, std::false_type, 
+                                                              const sca::agg::sum_t&, const sca::agg::mean_t&>::value));
+
+        const std::list<uint8_t> byte_list(bytes.begin(), bytes.end());
+        EXPECT_EQ(r, sca::aggregate(byte_list, sca::agg::sum, sca::agg::mean, sca::agg::max));
+
+        for(const size_t len : {15, 100, 4099}) {
+            std::vector<int8_t> small(len);
+            std::vector<int16_t> shorts(len);
+            for(size_t i = 0; i < len; ++i) {
+                small[i] = int8_t(i % 2 ? -128 : 127 - int(i % 7));
+                shorts[i] = int16_t(i % 3 ? -32768 : 32767);
+            }
+
+            int64_t small_sum = 0;
+            int64_t shorts_sum = 0;
+            for(size_t i = 0; i < len; ++i) {
+                small_sum += small[i];
+                shorts_sum += shorts[i];
+            }
+
+            auto rs = sca::aggregate(small, sca::agg::sum, sca::agg::min, sca::agg::mean);
+            EXPECT_EQ(small_sum, std::get<0>(rs));
+            EXPECT_EQ(-128, std::get<1>(rs));
+            EXPECT_DOUBLE_EQ(double(small_sum) / len, std::get<2>(rs));
+            EXPECT_EQ(shorts_sum, std::get<0>(sca::aggregate(shorts, sca::agg::sum)));
+        }
+
+        // float means are accumulated as doubles
+        const std::vector<float> floats(100003, 0.1f);
+        EXPECT_NEAR(0.1, std::get<0>(sca::aggregate(floats, sca::agg::mean)), 1e-7);
+        EXPECT_NEAR(0.1, std::get<0>(sca::aggregate(sca::reassociate, floats, sca::agg::mean)), 1e-7);
+    }
+
+    {
+        // user defined accumulators and non-contiguous containers
+        const std::list<int> l{1, 2, 3, 4};
+        auto r = sca::aggregate(l, lesson_7_ns::sum_of_squares(), sca::agg::mean, sca::agg::max);
+        EXPECT_EQ(30, std::get<0>(r));
+        EXPECT_EQ(2.5, std::get<1>(r));
+        EXPECT_EQ(4, std::get<2>(r));
+    }
+
+    {
+        // empty containers
+        const std::vector<float> v;
+        auto r = sca::aggregate(v, sca::agg::sum, sca::agg::min, sca::agg::count, sca::agg::mean);
+        EXPECT_EQ(0.0f, std::get<0>(r));
+        EXPECT_EQ(std::numeric_limits<float>::infinity(), std::get<1>(r));
+        EXPECT_EQ(0, std::get<2>(r));
+        EXPECT_TRUE(std::isnan(std::get<3>(r)));
+    }
+}
+
+TEST(lesson_7, fold_while) {
+    {
+        // stop as soon as a running sum crosses a budget
+        const std::vector<int> costs{5, 10, 20, 40, 80};
+        size_t calls = 0;
+        auto spent = sca::fold_until([&](int& total, int cost) { 
+            ++calls;
+            total += cost;
+            return total > 30;
+        }, 0, costs);
+        EXPECT_EQ(35, spent);
+        EXPECT_EQ(3, calls);
+
+        calls = 0;
+        auto under = sca::fold_while([&](int& total, int cost) { 
+            ++calls;
+            total += cost;
+            return total <= 1000;
+        }, 0, costs);
+        EXPECT_EQ(155, under);
+        EXPECT_EQ(5, calls);
+    }
+
+    {
+        // search multiple non random access containers for a target
+        const std::list<std::string> names{"a", "b", "c", "d"};
+        const std::forward_list<int> ids{1, 2, 3, 4};
+        size_t calls = 0;
+        auto found = sca::fold_while([&](std::pair<bool, int>& s, const std::string& n, int id) { 
+            ++calls;
+            if(n == "b") {
+                s = std::make_pair(true, id);
+            }
+            return !s.first;
+        }, std::make_pair(false, 0), names, ids);
+        EXPECT_TRUE(found.first);
+        EXPECT_EQ(2, found.second);
+        EXPECT_EQ(2, calls);
+    }
+
+    {
+        // empty containers return the initial state
+        const std::vector<int> v;
+        EXPECT_EQ(7, sca::fold_until([](int& s, int i) { s += i; return true; }, 7, v));
+    }
+}
+
+TEST(lesson_7, map_fold) {
+    {
+        // vectorized integer dot product and bitwise reductions, including a scalar tail
+        std::vector<int> a, b;
+        for(int i = 0; i < 1001; ++i) {
+            a.push_back(i % 17 - 8);
+            b.push_back(i % 5 + 1);
+        }
+
+        EXPECT_EQ(sca::dot(a, b), sca::map_fold(std::multiplies<>(), std::plus<>(), 0, a, b));
+        EXPECT_EQ(sca::dot(a, b) + 10, sca::map_fold(std::multiplies<>(), std::plus<>(), 10, a, b));
+        EXPECT_EQ(sca::fold(std::bit_xor<>(), 0, sca::map(std::plus<>(), a, b)), 
+                  sca::map_fold(std::plus<>(), std::bit_xor<>(), 0, a, b));
+        EXPECT_EQ(sca::fold(std::bit_and<>(), -1, sca::map(std::bit_or<>(), a, b)), 
+                  sca::map_fold(std::bit_or<>(), std::bit_and<>(), -1, a, b));
+    }
+
+    {
+        // floating point results are ordered unless reassociation is allowed
+        std::vector<double> a, b;
+        for(int i = 0; i < 1000; ++i) {
+            a.push_back(0.1 * i);
+            b.push_back(0.3 * (i % 7));
+        }
+
+        const double ordered = sca::fold(std::plus<>(), 0.0, sca::map(std::multiplies<>(), a, b));
+        EXPECT_EQ(ordered, sca::map_fold(std::multiplies<>(), std::plus<>(), 0.0, a, b));
+        EXPECT_NEAR(ordered, sca::map_fold(sca::reassociate, std::multiplies<>(), std::plus<>(), 0.0, a, b), 1e-6);
+    }
+
+    {
+        // arbitrary callables, a single container, non random access containers
+        const std::vector<std::string> words{"a", "bb", "ccc"};
+        EXPECT_EQ(6, sca::map_fold([](const std::string& s) { return s.size(); }, std::plus<>(), size_t(0), words));
+
+        const std::list<int> l{1, 2, 3};
+        const std::vector<std::string> names{"x", "y", "z"};
+        auto joined = sca::map_fold([](int i, const std::string& n) { return n + std::to_string(i); }, 
+                                    [](std::string acc, const std::string& s) { return acc + s; }, 
+                                    std::string(), l, names);
+        EXPECT_EQ("x1y2z3", joined);
+    }
+
+    {
+        // typed functors convert their arguments and results, and are not computed in the containers' lanes
+        const std::vector<float> a(64, 7.5f);
+        const std::vector<float> b(64, 2.0f);
+        EXPECT_EQ(192.0f, sca::map_fold(sca::reassociate, std::divides<int>(), std::plus<>(), 0.0f, a, b));
+
+        const std::vector<int> x(64, 300);
+        const std::vector<int> y(64, 300);
+        EXPECT_EQ(1565696, sca::map_fold(std::multiplies<short>(), std::plus<>(), 0, x, y));
+        EXPECT_FALSE((sca::detail::is_simd_map_fold_t<std::multiplies<short>, std::plus<>, int, std::false_type, 
+                                                      const std::vector<int>&, const std::vector<int>&>::value));
+    }
+
+    {
+        // empty containers return the initial value
+        const std::vector<int> a, b;
+        EXPECT_EQ(5, sca::map_fold(std::multiplies<>(), std::plus<>(), 5, a, b));
+    }
+}
+
+TEST(lesson_7, parallel_map_fold) {
+    {
+        // small and non random access containers evaluate as map_fold()
+        const std::list<int> l{1, 2, 3};
+        const std::vector<std::string> names{"x", "y", "z"};
+        auto joined = sca::map_fold(sca::parallel, 
+                                    [](int i, const std::string& n) { return n + std::to_string(i); }, 
+                                    [](std::string acc, const std::string& s) { return acc + s; }, 
+                                    std::string(), l, names);
+        EXPECT_EQ("x1y2z3", joined);
+
+        const std::vector<int> a, b;
+        EXPECT_EQ(5, sca::map_fold(sca::parallel, std::multiplies<>(), std::plus<>(), 5, a, b));
+    }
+
+    {
+        std::vector<int> a, b;
+        for(int i = 0; i < 300001; ++i) {
+            a.push_back(i % 17 - 8);
+            b.push_back(i % 5 + 1);
+        }
+
+        EXPECT_EQ(sca::dot(a, b) + 10, sca::map_fold(sca::parallel, std::multiplies<>(), std::plus<>(), 10, a, b));
+
+        // force several workers, whatever the count of hardware threads, 
+        // with vector kernels, arbitrary callables and more workers than elements
+        typedef std::integral_constant<bool, SCA_SIMD> simd;
+        std::multiplies<> mul;
+        std::plus<> add;
+        auto square = [](int x) { return (int64_t)x * x; };
+        const std::vector<int> small{1, 2, 3};
+
+        for(size_t workers : {2, 3, 7}) {
+            EXPECT_EQ(sca::dot(a, b) + 10, 
+                      sca::detail::parallel_map_fold(std::true_type(), simd(), mul, add, 10, workers, a, b));
+            EXPECT_EQ(sca::dot(a, b) + 10, 
+                      sca::detail::parallel_map_fold(std::true_type(), std::false_type(), mul, add, 10, workers, a, b));
+            EXPECT_EQ(sca::map_fold(square, add, int64_t(1), a), 
+                      sca::detail::parallel_map_fold(std::true_type(), std::false_type(), square, add, int64_t(1), workers, a));
+            EXPECT_EQ(15, sca::detail::parallel_map_fold(std::true_type(), std::false_type(), square, add, int64_t(1), 
+                                                         workers * 2, small));
+        }
+    }
+
+    {
+        // floating point partial results are reassociated
+        std::vector<double> a, b;
+        for(int i = 0; i < 1000; ++i) {
+            a.push_back(0.1 * i);
+            b.push_back(0.3 * (i % 7));
+        }
+
+        typedef std::integral_constant<bool, SCA_SIMD> simd;
+        std::multiplies<> mul;
+        std::plus<> add;
+        const double ordered = sca::map_fold(std::multiplies<>(), std::plus<>(), 0.0, a, b);
+        EXPECT_NEAR(ordered, sca::detail::parallel_map_fold(std::true_type(), simd(), mul, add, 0.0, 4, a, b), 1e-6);
+        EXPECT_NEAR(ordered, sca::detail::parallel_map_fold(std::true_type(), std::false_type(), mul, add, 0.0, 4, a, b), 1e-6);
+    }
+}